@@ -8,6 +8,9 @@
 #ifndef __GOLD_BITS_ANY_ANY_HPP
 #define __GOLD_BITS_ANY_ANY_HPP
 
+#include <bits/alloc_traits.h>
+#include <bits/uses_allocator.h>   // std::allocator_arg[_t]
+#include <memory_resource>         // std::pmr::polymorphic_allocator
 #include <gold/bits/any/fwd.hpp>
 #include <gold/bits/any/bad_any_access.hpp>
 #include <gold/bits/any/storage.hpp>
@@ -17,62 +20,93 @@
 namespace gold {
 
     //// [gold.any.any]
-    class any {
+    /// basic_any
+    // a copyable any-type that keeps values of at most 'InlineSize' bytes
+    // aligned to 'InlineAlign' inside itself; larger, over-aligned, or
+    // throwing-move values are allocated with 'Alloc'. the allocator is fixed
+    // for the lifetime of the object: moving or swapping between objects
+    // whose allocators compare unequal moves the values, not the storage
+    template <std::size_t InlineSize, std::size_t InlineAlign, typename Alloc>
+    class basic_any {
+      public:
+        using allocator_type = Alloc;
+
+        inline static constexpr std::size_t inline_size  = InlineSize;
+        inline static constexpr std::size_t inline_align = InlineAlign;
+
       private:
+        using buffer_type = __any::basic_sbo_buffer<InlineSize, InlineAlign>;
+
         union {
             // heap allocated (for both compile-time and runtime with suitable large-size types)
             __any::base_storage* m_ptr_;
             // preallocated (only for runtime with small-sized types)
-            __any::sbo_buffer    m_buf_;
+            buffer_type          m_buf_;
         };
 
-        auto (* m_manager_) (__any::manager_action, const any*, any*) -> __any::manager_result = nullptr;
+        const __any::vtable<basic_any>* m_vtable_ = nullptr;
+
+        [[no_unique_address]] allocator_type m_alloc_;
+
+        using alloc_traits = std::allocator_traits<allocator_type>;
 
         template <typename, typename>
         friend struct __any::manager;
 
         template <typename T>
-        using manager_type = __any::manager<T, any>;
-
-        constexpr __any::manager_result mf_manage_(__any::manager_action act, any* other = nullptr) {
-            return m_manager_(act, this, other);
-        }
-
-        constexpr __any::manager_result mf_manage_(__any::manager_action act, any* other = nullptr) const {
-            return m_manager_(act, this, other);
-        }
+        using manager_type = __any::manager<T, basic_any>;
 
         template <typename T>
-        static constexpr T* s_cast_to_ptr_(any* op) noexcept {
-            const bool not_null = op && op->has_value() && holds_current_type<T>(*op) && !std::is_function_v<T>;
-            if (not_null) {
+        static constexpr T* s_cast_to_ptr_(basic_any* op) noexcept {
+            if (op && holds_current_type<T>(*op) && !std::is_function_v<T>) {
                 return std::addressof(manager_type<T>::s_unsafe_get_(*op));
             }
             return nullptr;
         }
 
         template <typename T>
-        static constexpr const T* s_cast_to_ptr_(const any* op) noexcept {
-            return s_cast_to_ptr_<T>(const_cast<any*>(op));
+        static constexpr const T* s_cast_to_ptr_(const basic_any* op) noexcept {
+            return s_cast_to_ptr_<T>(const_cast<basic_any*>(op));
         }
 
       public:
         /// default ctor
-        constexpr any() noexcept
-        : m_manager_(nullptr) {
+        constexpr basic_any() noexcept
+        : m_vtable_(nullptr) {
+            if consteval { m_ptr_ = nullptr; }
+        }
+
+        /// allocator-extended default ctor
+        constexpr basic_any(std::allocator_arg_t, const allocator_type& alloc) noexcept
+        : m_vtable_(nullptr), m_alloc_(alloc) {
             if consteval { m_ptr_ = nullptr; }
         }
 
         /// copy ctor
-        constexpr any(const any& other) {
+        constexpr basic_any(const basic_any& other)
+        : m_alloc_(alloc_traits::select_on_container_copy_construction(other.m_alloc_)) {
             if (other.has_value())
-                other.mf_manage_(__any::manager_action::do_copy, this);
+                other.m_vtable_->copy(other, *this);
+        }
+
+        constexpr basic_any(std::allocator_arg_t, const allocator_type& alloc, const basic_any& other)
+        : m_alloc_(alloc) {
+            if (other.has_value())
+                other.m_vtable_->copy(other, *this);
         }
 
         /// move ctor
-        constexpr any(any&& other) {
+        constexpr basic_any(basic_any&& other)
+        : m_alloc_(other.m_alloc_) {
             if (other.has_value())
-                other.mf_manage_(__any::manager_action::do_move, this);
+                other.m_vtable_->move(other, *this);
+        }
+
+        // moves the value itself if 'alloc' cannot free 'other's storage
+        constexpr basic_any(std::allocator_arg_t, const allocator_type& alloc, basic_any&& other)
+        : m_alloc_(alloc) {
+            if (other.has_value())
+                other.m_vtable_->move(other, *this);
         }
 
         /// in-placed ctor
@@ -81,7 +115,17 @@ namespace gold {
                 { gold::decay_copy(op) } -> std::constructible_from<Args...>;
                 { gold::decay_copy(op) } -> std::copy_constructible;
             }
-        constexpr any(std::in_place_type_t<T>, Args&&... args) {
+        constexpr basic_any(std::in_place_type_t<T>, Args&&... args) {
+            manager_type<std::decay_t<T>>::s_create_(*this, std::in_place, std::forward<Args>(args)...);
+        }
+
+        template <typename T, typename... Args>
+            requires requires (T op) {
+                { gold::decay_copy(op) } -> std::constructible_from<Args...>;
+                { gold::decay_copy(op) } -> std::copy_constructible;
+            }
+        constexpr basic_any(std::allocator_arg_t, const allocator_type& alloc, std::in_place_type_t<T>, Args&&... args)
+        : m_alloc_(alloc) {
             manager_type<std::decay_t<T>>::s_create_(*this, std::in_place, std::forward<Args>(args)...);
         }
 
@@ -90,72 +134,103 @@ namespace gold {
                 { gold::decay_copy(op) } -> std::constructible_from<std::initializer_list<U>, Args...>;
                 { gold::decay_copy(op) } -> std::copy_constructible;
             }
-        constexpr any(std::in_place_type_t<T>, std::initializer_list<U> il, Args&&... args) {
+        constexpr basic_any(std::in_place_type_t<T>, std::initializer_list<U> il, Args&&... args) {
+            manager_type<std::decay_t<T>>::s_create_(*this, std::in_place, il, std::forward<Args>(args)...);
+        }
+
+        template <typename T, typename U, typename... Args>
+            requires requires (T op) {
+                { gold::decay_copy(op) } -> std::constructible_from<std::initializer_list<U>, Args...>;
+                { gold::decay_copy(op) } -> std::copy_constructible;
+            }
+        constexpr basic_any(std::allocator_arg_t, const allocator_type& alloc, std::in_place_type_t<T>,
+                            std::initializer_list<U> il, Args&&... args)
+        : m_alloc_(alloc) {
             manager_type<std::decay_t<T>>::s_create_(*this, std::in_place, il, std::forward<Args>(args)...);
         }
 
         /// direct ctor
         template <typename T>
-            requires (!std::same_as<std::decay_t<T>, any> && requires (T&& op) {
+            requires (!std::same_as<std::decay_t<T>, basic_any> && requires (T&& op) {
                 { gold::decay_copy(std::forward<T>(op)) } -> std::copy_constructible;
             })
-        constexpr any(T&& op) {
+        constexpr basic_any(T&& op) {
+            manager_type<std::decay_t<T>>::s_create_(*this, std::in_place, std::forward<T>(op));
+        }
+
+        template <typename T>
+            requires (!std::same_as<std::decay_t<T>, basic_any> && requires (T&& op) {
+                { gold::decay_copy(std::forward<T>(op)) } -> std::copy_constructible;
+            })
+        constexpr basic_any(std::allocator_arg_t, const allocator_type& alloc, T&& op)
+        : m_alloc_(alloc) {
             manager_type<std::decay_t<T>>::s_create_(*this, std::in_place, std::forward<T>(op));
         }
 
         /// dtor
-        constexpr ~any() { this->reset(); }
+        constexpr ~basic_any() { this->reset(); }
 
         /// copy assign
-        constexpr any& operator=(const any& other) {
+        constexpr basic_any& operator=(const basic_any& other) {
             if (this != &other)
-                auto(other).swap(*this);
+                basic_any(std::allocator_arg, m_alloc_, other).swap(*this);
             return *this;
         }
 
         /// move assign
-        constexpr any& operator=(any&& other) {
+        constexpr basic_any& operator=(basic_any&& other) {
             if (this != &other)
-                auto(std::move(other)).swap(*this);
+                basic_any(std::allocator_arg, m_alloc_, std::move(other)).swap(*this);
             return *this;
         }
 
         /// one-arg assign
         template <typename T>
-            requires (!std::same_as<std::decay_t<T>, any> && requires (T&& op) {
+            requires (!std::same_as<std::decay_t<T>, basic_any> && requires (T&& op) {
                 { gold::decay_copy(std::forward<T>(op)) } -> std::copy_constructible;
             })
-        constexpr any& operator=(T&& op) {
+        constexpr basic_any& operator=(T&& op) {
             if constexpr (std::copyable<std::decay_t<T>>) {
                 if (holds_current_type<std::decay_t<T>>(*this) && this->has_value()) {
                     *s_cast_to_ptr_<std::decay_t<T>>(this) = std::forward<T>(op);
                     return *this;
                 }
             }
-            any(std::forward<T>(op)).swap(*this);
+            basic_any(std::allocator_arg, m_alloc_, std::forward<T>(op)).swap(*this);
             return *this;
         }
 
         /// swap
-        constexpr void swap(any& other) noexcept {
+        // with allocators that may compare unequal, a held value is moved
+        // into storage allocated from the other object's allocator, which
+        // may throw
+        constexpr void swap(basic_any& other) noexcept(alloc_traits::is_always_equal::value) {
             if (this == &other)
                 return;
-            if (this->has_value() && other.has_value())
-                this->mf_manage_(__any::manager_action::do_swap, &other);
-            else if (this->has_value())
-                this->mf_manage_(__any::manager_action::do_move, &other);
-            else if (other.has_value())
-                other.mf_manage_(__any::manager_action::do_move, this);
+            if (this->has_value() && other.has_value()) {
+                if (m_vtable_ == other.m_vtable_) {
+                    m_vtable_->swap(*this, other);
+                } else {
+                    basic_any temp (std::allocator_arg, m_alloc_);
+                    other.m_vtable_->move(other, temp);
+                    m_vtable_->move(*this, other);
+                    temp.m_vtable_->move(temp, *this);
+                }
+            } else if (this->has_value()) {
+                m_vtable_->move(*this, other);
+            } else if (other.has_value()) {
+                other.m_vtable_->move(other, *this);
+            }
         }
 
-        friend constexpr void swap(any& lhs, any& rhs) noexcept {
+        friend constexpr void swap(basic_any& lhs, basic_any& rhs) noexcept(noexcept(lhs.swap(rhs))) {
             lhs.swap(rhs);
         }
 
         /// reset
         constexpr void reset() noexcept {
             if (this->has_value())
-                this->mf_manage_(__any::manager_action::do_destroy);
+                m_vtable_->destroy(*this);
         }
 
         /// emplace
@@ -179,13 +254,16 @@ namespace gold {
             return manager_type<std::decay_t<T>>::s_create_(*this, std::in_place, il, std::forward<Args>(args)...);
         }
 
+        /// get_allocator
+        constexpr allocator_type get_allocator() const noexcept { return m_alloc_; }
+
         /// has_value
-        constexpr bool has_value() const noexcept { return m_manager_ != nullptr; }
+        constexpr bool has_value() const noexcept { return m_vtable_ != nullptr; }
 
         /// view
         constexpr view_any view() const& noexcept {
             if (this->has_value())
-                return view_any(this->mf_manage_(__any::manager_action::do_get_view).view);
+                return view_any(m_vtable_->view(as_mutable(*this)));
             else
                 return view_any();
         }
@@ -194,84 +272,83 @@ namespace gold {
 
         /// type_info
         constexpr gold::ctype_info type_info() const noexcept {
-            if (this->has_value())
-                return this->mf_manage_(__any::manager_action::do_get_tinfo).tinfo;
-            else
-                return gold::ctype_id<void>();
+            return this->has_value() ? m_vtable_->tinfo : gold::ctype_id<void>();
         }
 
         /// type_name
         constexpr std::string_view type_name() const noexcept {
-            if (this->has_value())
-                return this->mf_manage_(__any::manager_action::do_get_tname).tname;
-            else
-                return "void";
+            return this->type_info().name();
         }
 
         /// type_size
         constexpr std::size_t type_size() const noexcept {
-            return this->has_value() ? this->mf_manage_(__any::manager_action::do_get_tsize).tsize : 0;
+            return this->has_value() ? m_vtable_->tsize : 0;
         }
 
         /// type_align
         constexpr std::size_t type_align() const noexcept {
-            return this->has_value() ? this->mf_manage_(__any::manager_action::do_get_talign).tsize : 0;
+            return this->has_value() ? m_vtable_->talign : 0;
         }
 
         /// operator==
-        constexpr bool operator==(const any& other) const {
+        constexpr bool operator==(const basic_any& other) const {
             if (!this->has_value() && !other.has_value())
                 return true;
             else if (!this->has_value() || !other.has_value())
                 return false;
             else {
-                auto result = this->mf_manage_(__any::manager_action::do_eq, &as_mutable(other));
-                if (result.kind == __any::manager_result_kind::none) {
+                if (m_vtable_->eq == nullptr) {
                     if consteval { __bad_any_access::unimplemented_equal_operator(); }
                     else { throw bad_any_access("no 'operator==' found in current type"); }
                 }
-                return result.eq;
+                return m_vtable_->eq(*this, other);
             }
         }
 
         /// operator<=>
-        constexpr auto operator<=>(const any& other) const {
+        constexpr auto operator<=>(const basic_any& other) const {
             using return_type = std::partial_ordering;
             if (!this->has_value() && !other.has_value())
                 return return_type::equivalent;
             else if (!this->has_value() || !other.has_value())
                 return return_type::unordered;
             else {
-                auto result = this->mf_manage_(__any::manager_action::do_cmp, &as_mutable(other));
-                if (result.kind == __any::manager_result_kind::none) {
+                if (m_vtable_->cmp == nullptr) {
                     if consteval { __bad_any_access::unimplemented_spaceship_operator(); }
                     else { throw bad_any_access("no 'operator<=>' found in current type"); }
                 }
-                return result.cmp;
+                return m_vtable_->cmp(*this, other);
             }
         }
 
         /// friend holds_current_type
         template <typename T>
-        friend constexpr bool holds_current_type(const any& op) noexcept {
-            return op.type_info() == gold::ctype_id<T>();
+        friend constexpr bool holds_current_type(const basic_any& op) noexcept {
+            return op.m_vtable_ != nullptr && op.m_vtable_->tinfo == gold::ctype_id<T>();
         }
 
         /// friend any_cast
         template <typename T>
             requires (!std::is_reference_v<T>)
-        friend constexpr const T* any_cast(const any* op) noexcept {
+        friend constexpr const T* any_cast(const basic_any* op) noexcept {
             return s_cast_to_ptr_<T>(op);
         }
 
         template <typename T>
             requires (!std::is_reference_v<T>)
-        friend constexpr T* any_cast(any* op) noexcept {
+        friend constexpr T* any_cast(basic_any* op) noexcept {
             return s_cast_to_ptr_<T>(op);
         }
 
     };
 
+    namespace pmr {
+
+        /// pmr::any [ spilled values come from a 'std::pmr::memory_resource' ]
+        using any = basic_any<3 * sizeof(void*), alignof(void*), std::pmr::polymorphic_allocator<std::byte>>;
+
+    } // namespace pmr
+
     /// make_any
     template <typename T, typename... Args>
         requires requires (T op) {
@@ -0,0 +1,357 @@
+// <gold/bits/any/any_vector.hpp> - gold++ library
+
+// Copyright (C) [ 2021 - 2024 ] - present Desmond Gold
+
+// note: internal header
+
+#pragma once
+#ifndef __GOLD_BITS_ANY_ANY_VECTOR_HPP
+#define __GOLD_BITS_ANY_ANY_VECTOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <utility>
+#include <vector>
+#include <gold/bits/any/fwd.hpp>
+#include <gold/bits/any/manager.hpp>
+#include <gold/bits/any/view_any.hpp>
+
+namespace gold {
+
+    class any_vector;
+
+    namespace __any {
+
+        /// __any::element_vtable
+        // operations on a value stored by 'any_vector'; 'relocate' is null when
+        // the bytes can be copied, 'destroy' when there is nothing to run
+        struct element_vtable {
+            gold::ctype_info tinfo;
+            std::size_t      tsize;
+            std::size_t      talign;
+
+            void (* relocate) (void* from, void* to) noexcept = nullptr;
+            void (* destroy) (void*) noexcept                 = nullptr;
+            mini_view_any (* view) (void*) noexcept           = nullptr;
+        };
+
+        /// __any::element_manager
+        template <typename T>
+        struct element_manager {
+
+            /// s_relocate_
+            static void s_relocate_(void* from, void* to) noexcept {
+                auto* src = static_cast<T*>(from);
+                ::new (to) T(std::move(*src));
+                src->~T();
+            }
+
+            /// s_destroy_
+            static void s_destroy_(void* op) noexcept {
+                static_cast<T*>(op)->~T();
+            }
+
+            /// s_view_
+            static mini_view_any s_view_(void* op) noexcept {
+                return manager<T, view_any>::s_create_mini_(*static_cast<T*>(op));
+            }
+
+            /// s_make_vtable_
+            static consteval element_vtable s_make_vtable_() noexcept {
+                element_vtable result { gold::ctype_id<T>(), sizeof(T), alignof(T) };
+                if constexpr (!std::is_trivially_copyable_v<T>)
+                    result.relocate = &s_relocate_;
+                if constexpr (!std::is_trivially_destructible_v<T>)
+                    result.destroy  = &s_destroy_;
+                result.view = &s_view_;
+                return result;
+            }
+        };
+
+        /// __any::element_vtable_for
+        template <typename T>
+        inline constexpr element_vtable element_vtable_for = element_manager<T>::s_make_vtable_();
+
+        /// __any::vector_storable
+        template <typename T>
+        concept vector_storable = std::is_object_v<T>
+            && !std::is_const_v<T> && !std::is_volatile_v<T> && !std::is_array_v<T>
+            && std::is_nothrow_move_constructible_v<T>
+            && std::is_nothrow_destructible_v<T>;
+
+    } // namespace __any
+
+    //// [gold.any.any_vector]
+    /// any_vector
+    // a sequence of values of different types packed into one growable block;
+    // every value sits at its natural alignment, next to the one before it,
+    // and a side array holds each value's offset and type. growing relocates
+    // the values, so references into it are invalidated like 'std::vector'
+    class any_vector {
+      public:
+        using size_type = std::size_t;
+
+      private:
+        struct entry {
+            std::size_t                   m_offset_;
+            const __any::element_vtable*  m_vtable_;
+        };
+
+        std::byte*          m_data_     = nullptr;
+        std::size_t         m_used_     = 0;  // bytes up to the end of the last value
+        std::size_t         m_capacity_ = 0;  // bytes
+        std::size_t         m_align_    = alignof(std::max_align_t); // of 'm_data_'
+        std::size_t         m_dtors_    = 0;  // values that need their destructor run
+        std::vector<entry>  m_entries_;
+
+        static constexpr std::size_t s_align_up_(std::size_t n, std::size_t align) noexcept {
+            return (n + align - 1) & ~(align - 1);
+        }
+
+        static std::byte* s_allocate_(std::size_t bytes, std::size_t align) {
+            return static_cast<std::byte*>(::operator new(bytes, std::align_val_t(align)));
+        }
+
+        static void s_deallocate_(std::byte* ptr, std::size_t align) noexcept {
+            ::operator delete(ptr, std::align_val_t(align));
+        }
+
+        void* mf_address_(const entry& e) const noexcept { return m_data_ + e.m_offset_; }
+
+        /// mf_grown_capacity_
+        std::size_t mf_grown_capacity_(std::size_t bytes) const noexcept {
+            return std::max(bytes, m_capacity_ * 2);
+        }
+
+        /// mf_grow_
+        void mf_grow_(std::size_t bytes, std::size_t align) {
+            const std::size_t capacity = this->mf_grown_capacity_(bytes);
+            this->mf_move_to_(s_allocate_(capacity, align), capacity, align);
+        }
+
+        /// mf_move_to_ [ offsets do not change, so alignment only has to hold for the block ]
+        void mf_move_to_(std::byte* data, std::size_t capacity, std::size_t align) noexcept {
+            if (m_used_ != 0) {
+                // values that are trivially copyable go with the bytes in between
+                std::memcpy(data, m_data_, m_used_);
+                for (const auto& e : m_entries_)
+                    if (e.m_vtable_->relocate != nullptr)
+                        e.m_vtable_->relocate(m_data_ + e.m_offset_, data + e.m_offset_);
+            }
+            if (m_data_ != nullptr)
+                s_deallocate_(m_data_, m_align_);
+            m_data_     = data;
+            m_capacity_ = capacity;
+            m_align_    = align;
+        }
+
+        /// mf_destroy_all_
+        void mf_destroy_all_() noexcept {
+            if (m_dtors_ != 0) {
+                for (const auto& e : m_entries_)
+                    if (e.m_vtable_->destroy != nullptr)
+                        e.m_vtable_->destroy(m_data_ + e.m_offset_);
+            }
+            m_dtors_ = 0;
+            m_used_  = 0;
+            m_entries_.clear();
+        }
+
+      public:
+        //// ctors, dtors, and assignments
+        any_vector() noexcept = default;
+
+        any_vector(const any_vector&) = delete;
+
+        any_vector(any_vector&& other) noexcept
+        : m_data_(std::exchange(other.m_data_, nullptr)),
+          m_used_(std::exchange(other.m_used_, 0)),
+          m_capacity_(std::exchange(other.m_capacity_, 0)),
+          m_align_(std::exchange(other.m_align_, alignof(std::max_align_t))),
+          m_dtors_(std::exchange(other.m_dtors_, 0)),
+          m_entries_(std::move(other.m_entries_)) {
+            other.m_entries_.clear();
+        }
+
+        ~any_vector() {
+            this->mf_destroy_all_();
+            if (m_data_ != nullptr)
+                s_deallocate_(m_data_, m_align_);
+        }
+
+        any_vector& operator=(const any_vector&) = delete;
+
+        any_vector& operator=(any_vector&& other) noexcept {
+            if (this != &other)
+                any_vector(std::move(other)).swap(*this);
+            return *this;
+        }
+
+        /// swap
+        void swap(any_vector& other) noexcept {
+            using std::swap;
+            swap(m_data_, other.m_data_);
+            swap(m_used_, other.m_used_);
+            swap(m_capacity_, other.m_capacity_);
+            swap(m_align_, other.m_align_);
+            swap(m_dtors_, other.m_dtors_);
+            swap(m_entries_, other.m_entries_);
+        }
+
+        friend void swap(any_vector& lhs, any_vector& rhs) noexcept {
+            lhs.swap(rhs);
+        }
+
+        //// modifiers
+        /// emplace_back
+        template <typename T, typename... Args>
+            requires __any::vector_storable<T> && std::constructible_from<T, Args...>
+        T& emplace_back(Args&&... args) {
+            const std::size_t align  = std::max(m_align_, alignof(T));
+            const std::size_t offset = s_align_up_(m_used_, alignof(T));
+            if (m_entries_.size() == m_entries_.capacity())
+                m_entries_.reserve(std::max<std::size_t>(16, m_entries_.size() * 2));
+
+            T* result;
+            if (offset + sizeof(T) > m_capacity_ || align > m_align_) {
+                // the value is made in the new block before the old one goes,
+                // since 'args' may refer to values stored here
+                const std::size_t capacity = this->mf_grown_capacity_(offset + sizeof(T));
+                auto* data = s_allocate_(capacity, align);
+                try {
+                    result = ::new (data + offset) T(std::forward<Args>(args)...);
+                } catch (...) {
+                    s_deallocate_(data, align);
+                    throw;
+                }
+                this->mf_move_to_(data, capacity, align);
+            } else {
+                result = ::new (m_data_ + offset) T(std::forward<Args>(args)...);
+            }
+            m_entries_.push_back({ offset, &__any::element_vtable_for<T> });
+            m_used_ = offset + sizeof(T);
+            if constexpr (!std::is_trivially_destructible_v<T>)
+                ++m_dtors_;
+            return *result;
+        }
+
+        /// push_back
+        template <typename T>
+            requires __any::vector_storable<std::decay_t<T>>
+        std::decay_t<T>& push_back(T&& value) {
+            return this->emplace_back<std::decay_t<T>>(std::forward<T>(value));
+        }
+
+        /// pop_back
+        void pop_back() noexcept {
+            const entry e = m_entries_.back();
+            if (e.m_vtable_->destroy != nullptr) {
+                e.m_vtable_->destroy(this->mf_address_(e));
+                --m_dtors_;
+            }
+            m_entries_.pop_back();
+            m_used_ = e.m_offset_;
+        }
+
+        /// clear [ runs no destructor when none of the values has one ]
+        void clear() noexcept { this->mf_destroy_all_(); }
+
+        /// reserve
+        // 'count' values taking about 'bytes' bytes in total
+        void reserve(size_type count, size_type bytes) {
+            m_entries_.reserve(count);
+            if (bytes > m_capacity_)
+                this->mf_grow_(bytes, m_align_);
+        }
+
+        //// observers
+        /// size
+        size_type size() const noexcept { return m_entries_.size(); }
+
+        /// empty
+        bool empty() const noexcept { return m_entries_.empty(); }
+
+        /// bytes_used
+        size_type bytes_used() const noexcept { return m_used_; }
+
+        /// bytes_capacity
+        size_type bytes_capacity() const noexcept { return m_capacity_; }
+
+        /// type_info
+        gold::ctype_info type_info(size_type pos) const noexcept {
+            return m_entries_[pos].m_vtable_->tinfo;
+        }
+
+        //// element access
+        /// operator[]
+        view_any operator[](size_type pos) const noexcept {
+            const entry& e = m_entries_[pos];
+            return view_any(e.m_vtable_->view(this->mf_address_(e)));
+        }
+
+        /// holds_type
+        template <typename T>
+        bool holds_type(size_type pos) const noexcept {
+            return m_entries_[pos].m_vtable_->tinfo == gold::ctype_id<T>();
+        }
+
+        /// get_if [ null if the value at 'pos' is not a 'T' ]
+        template <typename T>
+        T* get_if(size_type pos) noexcept {
+            const entry& e = m_entries_[pos];
+            if (e.m_vtable_->tinfo != gold::ctype_id<T>())
+                return nullptr;
+            return std::launder(static_cast<T*>(this->mf_address_(e)));
+        }
+
+        template <typename T>
+        const T* get_if(size_type pos) const noexcept {
+            return const_cast<any_vector*>(this)->get_if<T>(pos);
+        }
+
+        //// visitation
+        /// for_each [ every value, in order, as 'view_any' ]
+        template <typename F>
+        F for_each(F f) const {
+            for (const auto& e : m_entries_)
+                std::invoke(f, view_any(e.m_vtable_->view(this->mf_address_(e))));
+            return f;
+        }
+
+        /// for_each<T> [ the values of type 'T', in order ]
+        template <typename T, typename F>
+        F for_each(F f) {
+            const gold::ctype_info tinfo = gold::ctype_id<T>();
+            for (const auto& e : m_entries_)
+                if (e.m_vtable_->tinfo == tinfo)
+                    std::invoke(f, *std::launder(static_cast<T*>(this->mf_address_(e))));
+            return f;
+        }
+
+        /// visit<Ts...>
+        // groups the values by type: all of 'Ts...[0]' first, then all of
+        // 'Ts...[1]', and so on; values of other types are skipped
+        template <typename... Ts, typename F>
+            requires (sizeof...(Ts) > 0) && (std::invocable<F&, Ts&> && ...)
+        F visit(F f) {
+            (this->for_each<Ts>(std::ref(f)), ...);
+            return f;
+        }
+
+        /// count<T>
+        template <typename T>
+        size_type count() const noexcept {
+            const gold::ctype_info tinfo = gold::ctype_id<T>();
+            size_type result = 0;
+            for (const auto& e : m_entries_)
+                result += (e.m_vtable_->tinfo == tinfo);
+            return result;
+        }
+    };
+
+} // namespace gold
+
+#endif // __GOLD_BITS_ANY_ANY_VECTOR_HPP
@@ -1,6 +1,6 @@
 // <gold/bits/any/fwd.hpp> - gold++ library
 
-// Copyright (C) [ 2021 - 2023 ] - present Desmond Gold
+// Copyright (C) [ 2021 - 2024 ] - present Desmond Gold
 
 // note: internal header
 
@@ -8,16 +8,31 @@
 #ifndef __GOLD_BITS_ANY_FWD_HPP
 #define __GOLD_BITS_ANY_FWD_HPP
 
+#include <cstddef>
+#include <bits/allocator.h> // std::allocator
+
 namespace gold {
 
     /// view_any [fwd]
     class view_any;
 
-    /// any [fwd]
-    class any;
+    /// basic_any [fwd]
+    template <std::size_t InlineSize  = 3 * sizeof(void*),
+              std::size_t InlineAlign = alignof(void*),
+              typename Alloc          = std::allocator<std::byte>>
+    class basic_any;
+
+    /// basic_unique_any [fwd]
+    template <std::size_t InlineSize  = 3 * sizeof(void*),
+              std::size_t InlineAlign = alignof(void*),
+              typename Alloc          = std::allocator<std::byte>>
+    class basic_unique_any;
+
+    /// any
+    using any = basic_any<>;
 
-    /// unique_any [fwd]
-    class unique_any;
+    /// unique_any
+    using unique_any = basic_unique_any<>;
 
     namespace __any {
 
@@ -27,8 +42,9 @@ namespace gold {
         /// __any::sbo_buffer [fwd]
         struct sbo_buffer;
 
-        /// __any::manager_result [fwd]
-        struct manager_result;
+        /// __any::vtable [fwd]
+        template <typename Any>
+        struct vtable;
 
     } // namespace __any
 
@@ -1,6 +1,6 @@
 // <gold/bits/any/manager.hpp> - gold++ library
 
-// Copyright (C) [ 2021 - 2023 ] - present Desmond Gold
+// Copyright (C) [ 2021 - 2024 ] - present Desmond Gold
 
 // note: internal header
 
@@ -9,9 +9,11 @@
 #define __GOLD_BITS_ANY_MANAGER_HPP
 
 #include <compare>
-#include <bits/allocator.h>                    // std::allocator
+#include <bits/alloc_traits.h>                 // std::allocator_traits
+#include <bits/uses_allocator.h>               // std::allocator_arg
 #include <gold/ctype_info>
 #include <gold/bits/any/fwd.hpp>
+#include <gold/bits/any/storage.hpp>
 #include <gold/bits/memory/voidify.hpp>        // gold::voidify
 #include <gold/bits/memory/ops.hpp>
 #include <gold/bits/__util/cast_from_vptr.hpp> // gold::__util::cast_from_vptr
@@ -19,133 +21,45 @@
 
 namespace gold::__any {
 
-    /// __any::manager_action
-    enum class manager_action {
-        do_copy,
-        do_move,
-        do_swap,
-        do_destroy,
-        do_eq,
-        do_cmp,
-        do_get_data,
-        do_get_view,
-        do_get_tinfo,
-        do_get_tname,
-        do_get_tsize,
-        do_get_talign
-    };
-
-    /// __any::manager_result_kind
-    enum class manager_result_kind {
-        none, eq, cmp, data, view, tinfo, tname, tsize
+    /// __any::mini_view_any [fwd]
+    struct mini_view_any;
+
+    /// __any::vtable
+    // one constant table per stored type; the type info sits inline so that
+    // type checks compare two pointers without calling anything. 'copy' is
+    // null for move-only owners, 'eq' and 'cmp' when the type lacks them,
+    // and 'view' for 'view_any'
+    template <typename Any>
+    struct vtable {
+        gold::ctype_info tinfo;
+        std::size_t      tsize;
+        std::size_t      talign;
+
+        void (* copy) (const Any&, Any&)             = nullptr;
+        void (* move) (Any&, Any&)                   = nullptr;
+        void (* swap) (Any&, Any&)                   = nullptr; // same type on both sides
+        void (* destroy) (Any&) noexcept             = nullptr;
+        bool (* eq) (const Any&, const Any&)         = nullptr;
+        std::partial_ordering (* cmp) (const Any&, const Any&) = nullptr;
+        mini_view_any (* view) (Any&)                = nullptr;
     };
 
     /// __any::mini_view_any
     struct mini_view_any {
         void* m_ptr_ = nullptr;
-        auto (* m_manager_) (__any::manager_action, const view_any*, view_any*) -> __any::manager_result = nullptr;
+        const vtable<view_any>* m_vtable_ = nullptr;
     };
 
-    /// __any::start_lifetime_with [TODO move]
-    template <typename T>
-    constexpr void start_lifetime(T* op) {
-        if consteval { gold::construct_at(op); }
-        else { *op = T{}; }
-    }
-
-    template <typename T, typename U>
-    constexpr void start_lifetime(T* op, U&& u) {
-        if consteval { gold::construct_at(op, std::forward<U>(u)); }
-        else { *op = std::forward<U>(u); }
-    }
-
-    /// __any::manager_result
-    struct manager_result {
-        using none_result  = std::nullptr_t;
-        using eq_result    = bool;
-        using cmp_result   = std::partial_ordering;
-        using cget_result  = base_storage*;
-        using rget_result  = void*;
-        using view_result  = mini_view_any;
-        using tinfo_result = gold::ctype_info;
-        using tname_result = std::string_view;
-        using tsize_result = std::size_t;
-
-        union {
-            none_result  none;
-            eq_result    eq;
-            cmp_result   cmp;
-            cget_result  cget;
-            rget_result  rget;
-            view_result  view;
-            tinfo_result tinfo;
-            tname_result tname;
-            tsize_result tsize;
-        };
-
-        manager_result_kind kind;
-
-        static consteval manager_result get_none() {
-            return { .none { nullptr }, .kind = manager_result_kind::none };
-        }
-
-        static constexpr manager_result get_eq(eq_result b) {
-            manager_result result { {}, manager_result_kind::eq };
-            start_lifetime(&result.eq, b);
-            return result;
-        }
-
-        static constexpr manager_result get_cmp(cmp_result c) {
-            manager_result result { {}, manager_result_kind::cmp };
-            start_lifetime(&result.cmp, c);
-            return result;
-        }
-
-        static constexpr manager_result get_cget(cget_result g) {
-            manager_result result { {}, manager_result_kind::data };
-            start_lifetime(&result.cget, g);
-            return result;
-        }
-
-        static constexpr manager_result get_rget(rget_result g) {
-            manager_result result { {}, manager_result_kind::data };
-            start_lifetime(&result.rget, g);
-            return result;
-        }
-
-        static constexpr manager_result get_view(view_result v) {
-            manager_result result { {}, manager_result_kind::view };
-            start_lifetime(&result.view, v);
-            return result;
-        }
-
-        static constexpr manager_result get_tinfo(tinfo_result t) {
-            manager_result result { {}, manager_result_kind::tinfo };
-            start_lifetime(&result.tinfo, t);
-            return result;
-        }
-
-        static constexpr manager_result get_tname(tname_result t) {
-            manager_result result { {}, manager_result_kind::tname };
-            start_lifetime(&result.tname, t);
-            return result;
-        }
-
-        static constexpr manager_result get_tsize(tsize_result t) {
-            manager_result result { {}, manager_result_kind::tsize };
-            start_lifetime(&result.tsize, t);
-            return result;
-        }
-    };
+    /// __any::manager [fwd]
+    template <typename T, typename Any = void>
+    struct manager;
 
-    /// __any::as_lvalue [ TODO: delete ]
-    template <typename T>
-    constexpr T& as_lvalue(T&& op) noexcept {
-        return static_cast<T&>(op);
-    }
+    /// __any::vtable_for
+    template <typename T, typename Any>
+    inline constexpr vtable<Any> vtable_for = manager<T, Any>::s_make_vtable_();
 
     /// __any::manager
-    template <typename T, typename Any = void>
+    template <typename T, typename Any>
     struct manager {
         using element_type = T;
 
@@ -177,19 +91,9 @@ namespace gold::__any {
         /// s_tinfo_
         using base::s_tinfo_;
 
-        /// s_tinfo_from_
-        static constexpr gold::ctype_info s_tinfo_from_(const kind_any& op) noexcept {
-            return op.type_info();
-        }
-
         /// s_tname_
         using base::s_tname_;
 
-        /// s_tname_from_
-        static constexpr std::string_view s_tname_from_(const kind_any& op) noexcept {
-            return op.type_name();
-        }
-
         /// s_tsize_
         using base::s_tsize_;
 
@@ -198,136 +102,87 @@ namespace gold::__any {
 
         /// s_eq_type_
         static constexpr bool s_eq_type_(const kind_any& lhs, const kind_any& rhs) noexcept {
-            return lhs.type_info() == rhs.type_info();
+            return lhs.m_vtable_->tinfo == rhs.m_vtable_->tinfo;
         }
 
-        /// s_get_
-        static constexpr void* s_get_(kind_any& op) {
-            if (s_tinfo_from_(op) == s_tinfo_())
-                return op.m_ptr_;
-            else
-                return nullptr;
-        }
-
-        /// s_unsafe_get_
-        static constexpr element_type& s_unsafe_get_(kind_any& op) {
+        /// s_unsafe_get_ [ pre: 'op' holds 'element_type' ]
+        static constexpr element_type& s_unsafe_get_(kind_any& op) noexcept {
             if consteval {
-                return *gold::__util::cast_from_vptr<element_type*>(s_get_(op));
+                return *gold::__util::cast_from_vptr<element_type*>(op.m_ptr_);
             } else {
-                return *static_cast<element_type*>(s_get_(op));
+                return *static_cast<element_type*>(op.m_ptr_);
             }
         }
 
         /// s_create_
         static constexpr void s_create_(kind_any& dest_ref, element_type& op) noexcept {
-            dest_ref.m_ptr_     = __builtin_addressof(op);
-            dest_ref.m_manager_ = &manager::fn;
+            dest_ref.m_ptr_    = __builtin_addressof(op);
+            dest_ref.m_vtable_ = &vtable_for<T, Any>;
         }
 
         /// s_create_mini_
         static constexpr mini_view_any s_create_mini_(element_type& op) noexcept {
             mini_view_any result;
-            result.m_ptr_      = __builtin_addressof(op);
-            result.m_manager_ = &manager::fn;
+            result.m_ptr_    = __builtin_addressof(op);
+            result.m_vtable_ = &vtable_for<T, Any>;
             return result;
         }
 
-        /// s_destroy_and_sustain_manager_
-        static constexpr void s_destroy_and_sustain_manager_(kind_any& this_ref) noexcept {
-            this_ref.m_ptr_ = nullptr;
-        }
-
         /// s_destroy_
         static constexpr void s_destroy_(kind_any& this_ref) noexcept {
-            s_destroy_and_sustain_manager_(this_ref);
-            this_ref.m_manager_ = nullptr;
+            this_ref.m_ptr_    = nullptr;
+            this_ref.m_vtable_ = nullptr;
         }
 
         /// s_copy_
         static constexpr void s_copy_(const kind_any& this_ref, kind_any& dest_ref) noexcept {
-            dest_ref.m_ptr_     = this_ref.m_ptr_;
-            dest_ref.m_manager_ = this_ref.m_manager_;
-        }
-
-        /// s_move_and_sustain_manager_
-        static constexpr void s_move_and_sustain_manager_(kind_any& this_ref, kind_any& dest_ref) noexcept {
-            dest_ref.m_ptr_ = std::exchange(this_ref.m_ptr_, nullptr);
+            dest_ref.m_ptr_    = this_ref.m_ptr_;
+            dest_ref.m_vtable_ = this_ref.m_vtable_;
         }
 
         /// s_move_
         static constexpr void s_move_(kind_any& this_ref, kind_any& dest_ref) noexcept {
-            s_move_and_sustain_manager_(this_ref, dest_ref);
-            dest_ref.m_manager_  = std::exchange(this_ref.m_manager_, nullptr);
+            dest_ref.m_ptr_    = std::exchange(this_ref.m_ptr_, nullptr);
+            dest_ref.m_vtable_ = std::exchange(this_ref.m_vtable_, nullptr);
         }
 
         /// s_swap_
         static constexpr void s_swap_(kind_any& this_ref, kind_any& dest_ref) noexcept {
             using std::swap;
             swap(this_ref.m_ptr_, dest_ref.m_ptr_);
-            swap(this_ref.m_manager_, dest_ref.m_manager_);
+            swap(this_ref.m_vtable_, dest_ref.m_vtable_);
         }
 
         /// s_eq_
         static constexpr bool s_eq_(const kind_any& lhs, const kind_any& rhs) {
             // precondition:
             // lhs and rhs must both contain the same type or false
-            // lhs's contained type must be comparable or throw an exception
             return s_eq_type_(lhs, rhs) && (s_unsafe_get_(as_mutable(lhs)) == s_unsafe_get_(as_mutable(rhs)));
         }
 
         /// s_cmp_
         static constexpr std::partial_ordering s_cmp_(const kind_any& lhs, const kind_any& rhs) {
             // precondition:
-            // lhs and rhs must both contain the same type or false
-            // lhs's contained type must be 3-way comparable or throw an exception
+            // lhs and rhs must both contain the same type or unordered
             if (!s_eq_type_(lhs, rhs))
                 return std::partial_ordering::unordered;
 
             return s_unsafe_get_(as_mutable(lhs)) <=> s_unsafe_get_(as_mutable(rhs));
         }
 
-        /// fn
-        static constexpr manager_result fn(manager_action act,
-                                     const kind_any* this_ptr,
-                                           kind_any* other_ptr = nullptr) noexcept {
-            switch (act) {
-                using enum manager_action;
-                case do_copy:
-                    s_copy_(*this_ptr, *other_ptr);
-                    return manager_result::get_none();
-                case do_move:
-                    s_move_(as_mutable(*this_ptr), *other_ptr);
-                    return manager_result::get_none();
-                case do_swap:
-                    s_swap_(as_mutable(*this_ptr), *other_ptr);
-                    return manager_result::get_none();
-                case do_destroy:
-                    s_destroy_(as_mutable(*this_ptr));
-                    return manager_result::get_none();
-                case do_eq:
-                    if constexpr (std::equality_comparable<element_type>)
-                        return manager_result::get_eq(s_eq_(*this_ptr, *other_ptr));
-                    else
-                        return manager_result::get_none();
-                case do_cmp:
-                    if constexpr (std::three_way_comparable<element_type>)
-                        return manager_result::get_cmp(s_cmp_(*this_ptr, *other_ptr));
-                    else
-                        return manager_result::get_none();
-                case do_get_data:
-                    return manager_result::get_rget(s_get_(as_mutable(*this_ptr)));
-                case do_get_tinfo:
-                    return manager_result::get_tinfo(s_tinfo_());
-                case do_get_tname:
-                    return manager_result::get_tname(s_tname_());
-                case do_get_tsize:
-                    return manager_result::get_tsize(s_tsize_());
-                case do_get_talign:
-                    return manager_result::get_tsize(s_talign_());
-            }
-            gold::unreachable();
+        /// s_make_vtable_
+        static consteval vtable<kind_any> s_make_vtable_() noexcept {
+            vtable<kind_any> result { s_tinfo_(), s_tsize_(), s_talign_() };
+            result.copy    = &s_copy_;
+            result.move    = &s_move_;
+            result.swap    = &s_swap_;
+            result.destroy = &s_destroy_;
+            if constexpr (std::equality_comparable<element_type>)
+                result.eq  = &s_eq_;
+            if constexpr (std::three_way_comparable<element_type>)
+                result.cmp = &s_cmp_;
+            return result;
         }
-
     };
 
     /// __any::viewable_ptr
@@ -348,19 +203,9 @@ namespace gold::__any {
         /// s_tinfo_
         using base::s_tinfo_;
 
-        /// s_tinfo_from_
-        static constexpr gold::ctype_info s_tinfo_from_(const kind_any& op) noexcept {
-            return op.type_info();
-        }
-
         /// s_tname_
         using base::s_tname_;
 
-        /// s_tname_from_
-        static constexpr std::string_view s_tname_from_(const kind_any& op) noexcept {
-            return op.type_name();
-        }
-
         /// s_tsize_
         using base::s_tsize_;
 
@@ -369,141 +214,92 @@ namespace gold::__any {
 
         /// s_eq_type_
         static constexpr bool s_eq_type_(const kind_any& lhs, const kind_any& rhs) noexcept {
-            return lhs.type_info() == rhs.type_info();
-        }
-
-        /// s_get_
-        static constexpr void* s_get_(kind_any& op) {
-            if (s_tinfo_from_(op) == s_tinfo_())
-                return op.m_ptr_;
-            else
-                return nullptr;
+            return lhs.m_vtable_->tinfo == rhs.m_vtable_->tinfo;
         }
 
-        /// s_unsafe_get_
-        static constexpr element_type s_unsafe_get_(kind_any& op) {
+        /// s_unsafe_get_ [ pre: 'op' holds 'element_type' ]
+        static constexpr element_type s_unsafe_get_(kind_any& op) noexcept {
             if consteval {
-                return gold::__util::cast_from_vptr<element_type>(s_get_(op));
+                return gold::__util::cast_from_vptr<element_type>(op.m_ptr_);
             } else {
-                return static_cast<element_type>(s_get_(op));
+                return static_cast<element_type>(op.m_ptr_);
             }
         }
 
         /// s_create_
         static constexpr void s_create_(kind_any& dest_ref, element_type op) noexcept {
-            dest_ref.m_ptr_     = const_cast<void*>(static_cast<const void*>(op));
-            dest_ref.m_manager_ = &manager::fn;
+            dest_ref.m_ptr_    = const_cast<void*>(static_cast<const void*>(op));
+            dest_ref.m_vtable_ = &vtable_for<viewable_ptr<T*>, Any>;
         }
 
         /// s_create_mini_
         static constexpr mini_view_any s_create_mini_(element_type op) noexcept {
             mini_view_any result;
-            result.m_ptr_     = const_cast<void*>(static_cast<const void*>(op));
-            result.m_manager_ = &manager::fn;
+            result.m_ptr_    = const_cast<void*>(static_cast<const void*>(op));
+            result.m_vtable_ = &vtable_for<viewable_ptr<T*>, Any>;
             return result;
         }
 
-        /// s_destroy_and_sustain_manager_
-        static constexpr void s_destroy_and_sustain_manager_(kind_any& this_ref) noexcept {
-            this_ref.m_ptr_ = nullptr;
-        }
-
         /// s_destroy_
         static constexpr void s_destroy_(kind_any& this_ref) noexcept {
-            s_destroy_and_sustain_manager_(this_ref);
-            this_ref.m_manager_ = nullptr;
+            this_ref.m_ptr_    = nullptr;
+            this_ref.m_vtable_ = nullptr;
         }
 
         /// s_copy_
         static constexpr void s_copy_(const kind_any& this_ref, kind_any& dest_ref) noexcept {
-            dest_ref.m_ptr_     = this_ref.m_ptr_;
-            dest_ref.m_manager_ = this_ref.m_manager_;
-        }
-
-        /// s_move_and_sustain_manager_
-        static constexpr void s_move_and_sustain_manager_(kind_any& this_ref, kind_any& dest_ref) noexcept {
-            dest_ref.m_ptr_ = std::exchange(this_ref.m_ptr_, nullptr);
+            dest_ref.m_ptr_    = this_ref.m_ptr_;
+            dest_ref.m_vtable_ = this_ref.m_vtable_;
         }
 
         /// s_move_
         static constexpr void s_move_(kind_any& this_ref, kind_any& dest_ref) noexcept {
-            s_move_and_sustain_manager_(this_ref, dest_ref);
-            dest_ref.m_manager_  = std::exchange(this_ref.m_manager_, nullptr);
+            dest_ref.m_ptr_    = std::exchange(this_ref.m_ptr_, nullptr);
+            dest_ref.m_vtable_ = std::exchange(this_ref.m_vtable_, nullptr);
         }
 
         /// s_swap_
         static constexpr void s_swap_(kind_any& this_ref, kind_any& dest_ref) noexcept {
             using std::swap;
             swap(this_ref.m_ptr_, dest_ref.m_ptr_);
-            swap(this_ref.m_manager_, dest_ref.m_manager_);
+            swap(this_ref.m_vtable_, dest_ref.m_vtable_);
         }
 
         /// s_eq_
         static constexpr bool s_eq_(const kind_any& lhs, const kind_any& rhs) {
             // precondition:
             // lhs and rhs must both contain the same type or false
-            // lhs's contained type must be comparable or throw an exception
             return s_eq_type_(lhs, rhs) && (s_unsafe_get_(as_mutable(lhs)) == s_unsafe_get_(as_mutable(rhs)));
         }
 
         /// s_cmp_
         static constexpr std::partial_ordering s_cmp_(const kind_any& lhs, const kind_any& rhs) {
             // precondition:
-            // lhs and rhs must both contain the same type or false
-            // lhs's contained type must be 3-way comparable or throw an exception
+            // lhs and rhs must both contain the same type or unordered
             if (!s_eq_type_(lhs, rhs))
                 return std::partial_ordering::unordered;
 
             return s_unsafe_get_(as_mutable(lhs)) <=> s_unsafe_get_(as_mutable(rhs));
         }
 
-        /// fn
-        static constexpr manager_result fn(manager_action act,
-                                     const kind_any* this_ptr,
-                                           kind_any* other_ptr = nullptr) noexcept {
-            switch (act) {
-                using enum manager_action;
-                case do_copy:
-                    s_copy_(*this_ptr, *other_ptr);
-                    return manager_result::get_none();
-                case do_move:
-                    s_move_(as_mutable(*this_ptr), *other_ptr);
-                    return manager_result::get_none();
-                case do_swap:
-                    s_swap_(as_mutable(*this_ptr), *other_ptr);
-                    return manager_result::get_none();
-                case do_destroy:
-                    s_destroy_(as_mutable(*this_ptr));
-                    return manager_result::get_none();
-                case do_eq:
-                    if constexpr (std::equality_comparable<element_type>)
-                        return manager_result::get_eq(s_eq_(*this_ptr, *other_ptr));
-                    else
-                        return manager_result::get_none();
-                case do_cmp:
-                    if constexpr (std::three_way_comparable<element_type>)
-                        return manager_result::get_cmp(s_cmp_(*this_ptr, *other_ptr));
-                    else
-                        return manager_result::get_none();
-                case do_get_data:
-                    return manager_result::get_rget(s_get_(as_mutable(*this_ptr)));
-                case do_get_tinfo:
-                    return manager_result::get_tinfo(s_tinfo_());
-                case do_get_tname:
-                    return manager_result::get_tname(s_tname_());
-                case do_get_tsize:
-                    return manager_result::get_tsize(s_tsize_());
-                case do_get_talign:
-                    return manager_result::get_tsize(s_talign_());
-            }
-            gold::unreachable();
+        /// s_make_vtable_
+        static consteval vtable<kind_any> s_make_vtable_() noexcept {
+            vtable<kind_any> result { s_tinfo_(), s_tsize_(), s_talign_() };
+            result.copy    = &s_copy_;
+            result.move    = &s_move_;
+            result.swap    = &s_swap_;
+            result.destroy = &s_destroy_;
+            if constexpr (std::equality_comparable<element_type>)
+                result.eq  = &s_eq_;
+            if constexpr (std::three_way_comparable<element_type>)
+                result.cmp = &s_cmp_;
+            return result;
         }
-
     };
 
-    /// __any::manager<T, any> || __any::view<T, unique_any>
+    /// __any::manager<T, basic_any<...>> || __any::manager<T, basic_unique_any<...>>
     template <typename T, typename Any>
-        requires std::same_as<Any, any> || std::same_as<Any, unique_any>
+        requires owning_any<Any>
     struct manager<T, Any> : manager<T> {
 
         /// kind_any
@@ -515,28 +311,21 @@ namespace gold::__any {
         /// wrapped_element_type
         using wrapped_element_type = derived_storage<element_type>;
         /// allocator_type
-        using allocator_type = std::allocator<wrapped_element_type>;
+        using allocator_type = typename std::allocator_traits<typename any_traits<Any>::allocator_type>
+                                   ::template rebind_alloc<wrapped_element_type>;
+        /// alloc_traits
+        using alloc_traits   = std::allocator_traits<allocator_type>;
         /// is_sbo_compatible
-        inline static constexpr bool is_sbo_compatible = sbo_compatible<T>;
+        inline static constexpr bool is_sbo_compatible = sbo_compatible<T, typename any_traits<Any>::buffer_type>;
         /// is_copyable
-        inline static constexpr bool is_copyable       = std::same_as<Any, any>;
+        inline static constexpr bool is_copyable       = any_traits<Any>::is_copyable;
 
         /// s_tinfo_
         using base::s_tinfo_;
 
-        /// s_tinfo_from_
-        static constexpr gold::ctype_info s_tinfo_from_(const kind_any& op) noexcept {
-            return op.type_info();
-        }
-
         /// s_tname_
         using base::s_tname_;
 
-        /// s_tname_from_
-        static constexpr std::string_view s_tname_from_(const kind_any& op) noexcept {
-            return op.type_name();
-        }
-
         /// s_tsize_
         using base::s_tsize_;
 
@@ -545,24 +334,33 @@ namespace gold::__any {
 
         /// s_eq_type_
         static constexpr bool s_eq_type_(const kind_any& lhs, const kind_any& rhs) noexcept {
-            return lhs.type_info() == rhs.type_info();
+            return lhs.m_vtable_->tinfo == rhs.m_vtable_->tinfo;
         }
 
-        /// s_get_
-        static constexpr base_storage* s_get_(kind_any& this_ref) {
-            if (s_tinfo_from_(this_ref) == s_tinfo_()) {
-                if (is_sbo_compatible && !std::is_constant_evaluated())
-                    return static_cast<base_storage*>(gold::voidify(this_ref.m_buf_));
-                else
-                    return this_ref.m_ptr_;
-            } else {
-                return nullptr;
-            }
+        /// s_same_alloc_
+        // whether storage allocated by one can be freed by the other
+        static constexpr bool s_same_alloc_(const kind_any& lhs, const kind_any& rhs) noexcept {
+            if constexpr (alloc_traits::is_always_equal::value)
+                return true;
+            else
+                return lhs.m_alloc_ == rhs.m_alloc_;
+        }
+
+        /// s_storage_ [ pre: 'this_ref' holds 'element_type' ]
+        static constexpr wrapped_element_type* s_storage_(kind_any& this_ref) noexcept {
+            if (is_sbo_compatible && !std::is_constant_evaluated())
+                return static_cast<wrapped_element_type*>(gold::voidify(this_ref.m_buf_));
+            else
+                return static_cast<wrapped_element_type*>(this_ref.m_ptr_);
+        }
+
+        static constexpr const wrapped_element_type* s_storage_(const kind_any& this_ref) noexcept {
+            return s_storage_(as_mutable(this_ref));
         }
 
-        /// s_unsafe_get_
-        static constexpr element_type& s_unsafe_get_(kind_any& this_ref) {
-            return static_cast<wrapped_element_type*>(s_get_(this_ref))->value;
+        /// s_unsafe_get_ [ pre: 'this_ref' holds 'element_type' ]
+        static constexpr element_type& s_unsafe_get_(kind_any& this_ref) noexcept {
+            return s_storage_(this_ref)->value;
         }
 
         /// s_get_view_
@@ -576,199 +374,151 @@ namespace gold::__any {
             if (is_sbo_compatible && !std::is_constant_evaluated()) {
                 auto* result = static_cast<wrapped_element_type*>(gold::voidify(dest_ref.m_buf_));
                 gold::construct_at(result, std::in_place, std::forward<Args>(args)...);
-                dest_ref.m_manager_ = &manager::fn;
+                dest_ref.m_vtable_ = &vtable_for<T, Any>;
                 return result->value;
             } else {
-                allocator_type alloc;
-                auto* result = alloc.allocate(1);
-                gold::construct_at(result, std::in_place, std::forward<Args>(args)...);
+                allocator_type alloc (dest_ref.m_alloc_);
+                auto* result = alloc_traits::allocate(alloc, 1);
+                try {
+                    gold::construct_at(result, std::in_place, std::forward<Args>(args)...);
+                } catch (...) {
+                    alloc_traits::deallocate(alloc, result, 1);
+                    throw;
+                }
                 dest_ref.m_ptr_ = result;
-                dest_ref.m_manager_ = &manager::fn;
+                dest_ref.m_vtable_ = &vtable_for<T, Any>;
                 return result->value;
             }
         }
 
         static constexpr element_type& s_create_(kind_any& dest_ref, const element_type& arg) {
-            if (is_sbo_compatible && !std::is_constant_evaluated()) {
-                auto* result = static_cast<wrapped_element_type*>(gold::voidify(dest_ref.m_buf_));
-                gold::construct_at(result, std::in_place, arg);
-                dest_ref.m_manager_ = &manager::fn;
-                return result->value;
-            } else {
-                allocator_type alloc;
-                auto* result = alloc.allocate(1);
-                gold::construct_at(result, std::in_place, arg);
-                dest_ref.m_ptr_ = result;
-                dest_ref.m_manager_ = &manager::fn;
-                return result->value;
-            }
+            return s_create_(dest_ref, std::in_place, arg);
         }
 
         static constexpr element_type& s_create_(kind_any& dest_ref, element_type&& arg) {
-            if (is_sbo_compatible && !std::is_constant_evaluated()) {
-                auto* result = static_cast<wrapped_element_type*>(gold::voidify(dest_ref.m_buf_));
-                gold::construct_at(result, std::in_place, std::move(arg));
-                dest_ref.m_manager_ = &manager::fn;
-                return result->value;
-            } else {
-                allocator_type alloc;
-                auto* result = alloc.allocate(1);
-                gold::construct_at(result, std::in_place, std::move(arg));
-                dest_ref.m_ptr_ = result;
-                dest_ref.m_manager_ = &manager::fn;
-                return result->value;
-            }
+            return s_create_(dest_ref, std::in_place, std::move(arg));
         }
 
         /// s_destroy_and_sustain_manager_
         static constexpr void s_destroy_and_sustain_manager_(kind_any& this_ref) noexcept {
             if (is_sbo_compatible && !std::is_constant_evaluated()) {
-                auto* ptr = static_cast<wrapped_element_type*>(gold::voidify(this_ref.m_buf_));
-                gold::destroy_at(ptr);
+                gold::destroy_at(s_storage_(this_ref));
             } else {
-                allocator_type alloc;
-                auto* ptr = static_cast<wrapped_element_type*>(this_ref.m_ptr_);
+                allocator_type alloc (this_ref.m_alloc_);
+                auto* ptr = s_storage_(this_ref);
                 gold::destroy_at(ptr);
-                alloc.deallocate(ptr, 1);
+                alloc_traits::deallocate(alloc, ptr, 1);
             }
         }
 
         /// s_destroy_
         static constexpr void s_destroy_(kind_any& this_ref) noexcept {
             s_destroy_and_sustain_manager_(this_ref);
-            this_ref.m_manager_ = nullptr;
+            this_ref.m_vtable_ = nullptr;
         }
 
         /// s_copy_
         static constexpr void s_copy_(const kind_any& this_ref, kind_any& dest_ref) requires is_copyable {
+            // 'dest_ref' is empty, so the value is always constructed
             if (is_sbo_compatible && !std::is_constant_evaluated()) {
-                auto* this_data = static_cast<const wrapped_element_type*>(gold::voidify(this_ref.m_buf_));
                 auto* dest_data = static_cast<wrapped_element_type*>(gold::voidify(dest_ref.m_buf_));
-                if constexpr (std::copyable<element_type>)
-                    *dest_data = *this_data;
-                else
-                    gold::construct_at(dest_data, *this_data);
+                gold::construct_at(dest_data, *s_storage_(this_ref));
             } else {
-                allocator_type alloc;
-                auto* this_data = static_cast<const wrapped_element_type*>(this_ref.m_ptr_);
-                auto* dest_data = alloc.allocate(1);
-                gold::construct_at(dest_data, *this_data);
+                allocator_type alloc (dest_ref.m_alloc_);
+                auto* dest_data = alloc_traits::allocate(alloc, 1);
+                try {
+                    gold::construct_at(dest_data, *s_storage_(this_ref));
+                } catch (...) {
+                    alloc_traits::deallocate(alloc, dest_data, 1);
+                    throw;
+                }
                 dest_ref.m_ptr_ = dest_data;
             }
-            dest_ref.m_manager_ = this_ref.m_manager_;
+            dest_ref.m_vtable_ = this_ref.m_vtable_;
         }
 
         /// s_move_and_sustain_manager_
         static constexpr void s_move_and_sustain_manager_(kind_any& this_ref, kind_any& dest_ref) {
+            // 'dest_ref' holds no value; 'this_ref' holds none afterwards
             if (is_sbo_compatible && !std::is_constant_evaluated()) {
-                auto* this_data = static_cast<const wrapped_element_type*>(gold::voidify(this_ref.m_buf_));
+                auto* this_data = s_storage_(this_ref);
                 auto* dest_data = static_cast<wrapped_element_type*>(gold::voidify(dest_ref.m_buf_));
-                if constexpr (std::movable<element_type>)
-                    *dest_data = std::move(*this_data);
-                else {
-                    gold::construct_at(dest_data, std::move(*this_data));
-                    s_destroy_and_sustain_manager_(this_ref);
-                }
-            } else {
+                gold::construct_at(dest_data, std::move(*this_data));
+                gold::destroy_at(this_data);
+            } else if (s_same_alloc_(this_ref, dest_ref)) {
                 dest_ref.m_ptr_ = std::exchange(this_ref.m_ptr_, nullptr);
+            } else {
+                // the value has to move into memory owned by 'dest_ref'
+                allocator_type alloc (dest_ref.m_alloc_);
+                auto* dest_data = alloc_traits::allocate(alloc, 1);
+                try {
+                    gold::construct_at(dest_data, std::move(*s_storage_(this_ref)));
+                } catch (...) {
+                    alloc_traits::deallocate(alloc, dest_data, 1);
+                    throw;
+                }
+                s_destroy_and_sustain_manager_(this_ref);
+                dest_ref.m_ptr_ = dest_data;
             }
         }
 
         /// s_move_
         static constexpr void s_move_(kind_any& this_ref, kind_any& dest_ref) {
             s_move_and_sustain_manager_(this_ref, dest_ref);
-            dest_ref.m_manager_ = std::exchange(this_ref.m_manager_, nullptr);
+            dest_ref.m_vtable_ = std::exchange(this_ref.m_vtable_, nullptr);
         }
 
         /// s_swap_
         static constexpr void s_swap_(kind_any& lhs, kind_any& rhs) {
-
-            // precondition: both 'lhs' and 'rhs' must contain a value
-            using std::swap;
-            swap(lhs.m_manager_, rhs.m_manager_);
+            // precondition: both 'lhs' and 'rhs' must hold 'element_type'
+            if ((!is_sbo_compatible || std::is_constant_evaluated()) && s_same_alloc_(lhs, rhs)) {
+                using std::swap;
+                swap(lhs.m_ptr_, rhs.m_ptr_);
+                return;
+            }
 
             if constexpr (std::swappable<element_type>) {
-                if not consteval {
-                    auto* lhs_data = is_sbo_compatible
-                                   ? static_cast<wrapped_element_type*>(gold::voidify(lhs.m_buf_))
-                                   : static_cast<wrapped_element_type*>(lhs.m_ptr_);
-                    auto* rhs_data = is_sbo_compatible
-                                   ? static_cast<wrapped_element_type*>(gold::voidify(rhs.m_buf_))
-                                   : static_cast<wrapped_element_type*>(rhs.m_ptr_);
-                    swap(lhs_data->value, rhs_data->value);
-                    return;
-                }
+                using std::swap;
+                swap(s_unsafe_get_(lhs), s_unsafe_get_(rhs));
+            } else {
+                kind_any temp (std::allocator_arg, lhs.m_alloc_);
+                s_move_and_sustain_manager_(lhs, temp);
+                s_move_and_sustain_manager_(rhs, lhs);
+                s_move_and_sustain_manager_(temp, rhs);
             }
-
-            kind_any temp;
-            s_move_and_sustain_manager_(lhs, temp);
-            s_move_and_sustain_manager_(rhs, lhs);
-            s_move_and_sustain_manager_(temp, rhs);
         }
 
         /// s_eq_
         static constexpr bool s_eq_(const kind_any& lhs, const kind_any& rhs) {
             // precondition:
             // lhs and rhs must both contain the same type or false
-            // lhs's contained type must be comparable or throw an exception
             return s_eq_type_(lhs, rhs) && (s_unsafe_get_(as_mutable(lhs)) == s_unsafe_get_(as_mutable(rhs)));
         }
 
         /// s_cmp_
         static constexpr std::partial_ordering s_cmp_(const kind_any& lhs, const kind_any& rhs) {
             // precondition:
-            // lhs and rhs must both contain the same type or false
-            // lhs's contained type must be 3-way comparable or throw an exception
+            // lhs and rhs must both contain the same type or unordered
             if (!s_eq_type_(lhs, rhs))
                 return std::partial_ordering::unordered;
 
             return s_unsafe_get_(as_mutable(lhs)) <=> s_unsafe_get_(as_mutable(rhs));
         }
 
-        /// fn
-        static constexpr manager_result fn(manager_action act,
-                                     const kind_any* this_ptr,
-                                           kind_any* other_ptr = nullptr) noexcept {
-            switch (act) {
-                using enum manager_action;
-                case do_copy:
-                    if constexpr (is_copyable)
-                        s_copy_(*this_ptr, *other_ptr);
-                    return manager_result::get_none();
-                case do_move:
-                    s_move_(as_mutable(*this_ptr), *other_ptr);
-                    return manager_result::get_none();
-                case do_swap:
-                    s_swap_(as_mutable(*this_ptr), *other_ptr);
-                    return manager_result::get_none();
-                case do_destroy:
-                    s_destroy_(as_mutable(*this_ptr));
-                    return manager_result::get_none();
-                case do_eq:
-                    if constexpr (std::equality_comparable<element_type>)
-                        return manager_result::get_eq(s_eq_(*this_ptr, *other_ptr));
-                    else
-                        return manager_result::get_none();
-                case do_cmp:
-                    if constexpr (std::three_way_comparable<element_type>)
-                        return manager_result::get_cmp(s_cmp_(*this_ptr, *other_ptr));
-                    else
-                        return manager_result::get_none();
-                case do_get_data:
-                    return manager_result::get_cget(s_get_(as_mutable(*this_ptr)));
-                case do_get_view:
-                    return manager_result::get_view(s_get_view_(as_mutable(*this_ptr)));
-                case do_get_tinfo:
-                    return manager_result::get_tinfo(s_tinfo_());
-                case do_get_tname:
-                    return manager_result::get_tname(s_tname_());
-                case do_get_tsize:
-                    return manager_result::get_tsize(s_tsize_());
-                case do_get_talign:
-                    return manager_result::get_tsize(s_talign_());
-                default:;
-            }
-            gold::unreachable();
+        /// s_make_vtable_
+        static consteval vtable<kind_any> s_make_vtable_() noexcept {
+            vtable<kind_any> result { s_tinfo_(), s_tsize_(), s_talign_() };
+            if constexpr (is_copyable)
+                result.copy = &s_copy_;
+            result.move    = &s_move_;
+            result.swap    = &s_swap_;
+            result.destroy = &s_destroy_;
+            if constexpr (std::equality_comparable<element_type>)
+                result.eq  = &s_eq_;
+            if constexpr (std::three_way_comparable<element_type>)
+                result.cmp = &s_cmp_;
+            result.view    = &s_get_view_;
+            return result;
         }
     };
 
@@ -1,6 +1,6 @@
 // <gold/bits/any/storage.hpp> - gold++ library
 
-// Copyright (C) [ 2021 - 2022 ] - present Desmond Gold
+// Copyright (C) [ 2021 - 2024 ] - present Desmond Gold
 
 // note: internal header
 
@@ -11,7 +11,9 @@
 #include <gold/bits/any/fwd.hpp>
 #include <gold/bits/concepts/types.hpp> // gold::brace_constructible_from
 #include <gold/bits/in_place.hpp>       // std::in_place[_t], gold::in_place_braced[_t]
+#include <bit>
 #include <concepts>
+#include <cstddef>
 
 namespace gold::__any {
 
@@ -42,17 +44,52 @@ namespace gold::__any {
         constexpr derived_storage& operator=(derived_storage&&) noexcept requires std::movable<T> = default;
     };
 
+    /// __any::basic_sbo_buffer
+    template <std::size_t Size, std::size_t Align>
+    struct basic_sbo_buffer {
+        static_assert(Size >= sizeof(void*), "the inline buffer must be able to hold a pointer");
+        static_assert(std::has_single_bit(Align), "the inline alignment must be a power of two");
+
+        alignas(Align) std::byte data[Size];
+    };
+
     /// __any::sbo_buffer
-    struct alignas(void*) sbo_buffer {
-        /* alignas(void*) */ std::byte data[3 * sizeof(void*)];
-    } __attribute__((packed));
+    struct sbo_buffer : basic_sbo_buffer<3 * sizeof(void*), alignof(void*)> {};
 
     /// __any::sbo_compatible
-    template <typename T>
-    concept sbo_compatible = sizeof(T) <= sizeof(sbo_buffer)
-        && alignof(sbo_buffer) % alignof(T) == 0
+    template <typename T, typename Buffer = sbo_buffer>
+    concept sbo_compatible = sizeof(derived_storage<T>) <= sizeof(Buffer)
+        && alignof(Buffer) % alignof(derived_storage<T>) == 0
         && std::is_nothrow_move_constructible_v<T>;
 
+    /// __any::any_traits
+    // what an owning any-type needs to know about itself, available
+    // before the any-type is complete
+    template <typename Any>
+    struct any_traits {
+        inline static constexpr bool is_owning = false;
+    };
+
+    template <std::size_t Size, std::size_t Align, typename Alloc>
+    struct any_traits<basic_any<Size, Align, Alloc>> {
+        using buffer_type    = basic_sbo_buffer<Size, Align>;
+        using allocator_type = Alloc;
+        inline static constexpr bool is_owning   = true;
+        inline static constexpr bool is_copyable = true;
+    };
+
+    template <std::size_t Size, std::size_t Align, typename Alloc>
+    struct any_traits<basic_unique_any<Size, Align, Alloc>> {
+        using buffer_type    = basic_sbo_buffer<Size, Align>;
+        using allocator_type = Alloc;
+        inline static constexpr bool is_owning   = true;
+        inline static constexpr bool is_copyable = false;
+    };
+
+    /// __any::owning_any
+    template <typename Any>
+    concept owning_any = any_traits<Any>::is_owning;
+
 } // namespace gold::__any
 
 #endif // __GOLD_BITS_ANY_STORAGE_HPP
@@ -20,7 +20,7 @@ namespace gold {
     class view_any {
       private:
         void* m_ptr_ = nullptr;
-        auto (* m_manager_) (__any::manager_action, const view_any*, view_any*) -> __any::manager_result = nullptr;
+        const __any::vtable<view_any>* m_vtable_ = nullptr;
 
         template <typename, typename>
         friend struct __any::manager;
@@ -28,23 +28,13 @@ namespace gold {
         template <typename T>
         using manager_type = __any::manager<T, view_any>;
 
-        constexpr __any::manager_result mf_manage_(__any::manager_action act, view_any* other = nullptr) {
-            return m_manager_(act, this, other);
-        }
-
-        constexpr __any::manager_result mf_manage_(__any::manager_action act, view_any* other = nullptr) const {
-            return m_manager_(act, this, other);
-        }
-
         template <typename T>
         static constexpr T* s_cast_to_ptr_(view_any* op) noexcept {
-            const bool not_null = op && op->has_value() && holds_current_type<T>(*op) && !std::is_function_v<T>;
-            if (not_null) {
-                auto result = op->mf_manage_(__any::manager_action::do_get_data).rget;
+            if (op && holds_current_type<T>(*op) && !std::is_function_v<T>) {
                 if consteval {
-                    return gold::__util::cast_from_vptr<T*>(result);
+                    return gold::__util::cast_from_vptr<T*>(op->m_ptr_);
                 } else {
-                    return static_cast<T*>(result);
+                    return static_cast<T*>(op->m_ptr_);
                 }
             }
             return nullptr;
@@ -57,13 +47,11 @@ namespace gold {
 
         template <typename T>
         static constexpr T s_cast_to_ptr_(in_place_viewable_t, const view_any* op) noexcept {
-            const bool not_null = op && op->has_value() && holds_current_type<T>(*op) && !std::is_function_v<T>;
-            if (not_null) {
-                auto result = op->mf_manage_(__any::manager_action::do_get_data).rget;
+            if (op && holds_current_type<T>(*op) && !std::is_function_v<T>) {
                 if consteval {
-                    return gold::__util::cast_from_vptr<T>(result);
+                    return gold::__util::cast_from_vptr<T>(op->m_ptr_);
                 } else {
-                    return static_cast<T>(result);
+                    return static_cast<T>(op->m_ptr_);
                 }
             }
             return nullptr;
@@ -71,10 +59,15 @@ namespace gold {
 
         /// private ctor
         constexpr view_any(__any::mini_view_any other)
-        : m_ptr_(other.m_ptr_), m_manager_(other.m_manager_) {}
+        : m_ptr_(other.m_ptr_), m_vtable_(other.m_vtable_) {}
 
-        friend any;
-        friend unique_any;
+        template <std::size_t, std::size_t, typename>
+        friend class basic_any;
+
+        template <std::size_t, std::size_t, typename>
+        friend class basic_unique_any;
+
+        friend class any_vector;
 
       public:
 
@@ -84,13 +77,13 @@ namespace gold {
         /// copy ctor
         constexpr view_any(const view_any& other) {
             if (other.has_value())
-                other.mf_manage_(__any::manager_action::do_copy, this);
+                other.m_vtable_->copy(other, *this);
         }
 
         /// move ctor
         constexpr view_any(view_any&& other) {
             if (other.has_value())
-                other.mf_manage_(__any::manager_action::do_move, this);
+                other.m_vtable_->move(other, *this);
         }
 
         /// custom ctor
@@ -143,12 +136,9 @@ namespace gold {
         constexpr void swap(view_any& other) noexcept {
             if (this == &other)
                 return;
-            if (this->has_value() && other.has_value())
-                this->mf_manage_(__any::manager_action::do_swap, &other);
-            else if (this->has_value())
-                this->mf_manage_(__any::manager_action::do_move, &other);
-            else
-                other.mf_manage_(__any::manager_action::do_move, this);
+            using std::swap;
+            swap(m_ptr_, other.m_ptr_);
+            swap(m_vtable_, other.m_vtable_);
         }
 
         friend constexpr void swap(view_any& lhs, view_any& rhs) noexcept {
@@ -158,7 +148,7 @@ namespace gold {
         /// reset
         constexpr void reset() noexcept {
             if (this->has_value())
-                this->mf_manage_(__any::manager_action::do_destroy);
+                m_vtable_->destroy(*this);
         }
 
         /// emplace
@@ -169,32 +159,26 @@ namespace gold {
         }
 
         /// has_value
-        constexpr bool has_value() const noexcept { return m_manager_ != nullptr; }
+        constexpr bool has_value() const noexcept { return m_vtable_ != nullptr; }
 
         /// type_info
         constexpr gold::ctype_info type_info() const noexcept {
-            if (this->has_value())
-                return this->mf_manage_(__any::manager_action::do_get_tinfo).tinfo;
-            else
-                return gold::ctype_id<void>();
+            return this->has_value() ? m_vtable_->tinfo : gold::ctype_id<void>();
         }
 
         /// type_name
         constexpr std::string_view type_name() const noexcept {
-            if (this->has_value())
-                return this->mf_manage_(__any::manager_action::do_get_tname).tname;
-            else
-                return "void";
+            return this->type_info().name();
         }
 
         /// type_size
         constexpr std::size_t type_size() const noexcept {
-            return this->has_value() ? this->mf_manage_(__any::manager_action::do_get_tsize).tsize : 0;
+            return this->has_value() ? m_vtable_->tsize : 0;
         }
 
         /// type_align
         constexpr std::size_t type_align() const noexcept {
-            return this->has_value() ? this->mf_manage_(__any::manager_action::do_get_talign).tsize : 0;
+            return this->has_value() ? m_vtable_->talign : 0;
         }
 
         /// operator==
@@ -204,12 +188,11 @@ namespace gold {
             else if (!this->has_value() || !other.has_value())
                 return false;
             else {
-                auto result = this->mf_manage_(__any::manager_action::do_eq, &as_mutable(other));
-                if (result.kind == __any::manager_result_kind::none) {
+                if (m_vtable_->eq == nullptr) {
                     if consteval { __bad_any_access::unimplemented_equal_operator(); }
                     else { throw bad_any_access("no 'operator==' found in current type"); }
                 }
-                return result.eq;
+                return m_vtable_->eq(*this, other);
             }
         }
 
@@ -227,12 +210,11 @@ namespace gold {
             else if (!this->has_value() || !other.has_value())
                 return return_type::unordered;
             else {
-                auto result = this->mf_manage_(__any::manager_action::do_cmp, &as_mutable(other));
-                if (result.kind == __any::manager_result_kind::none) {
+                if (m_vtable_->cmp == nullptr) {
                     if consteval { __bad_any_access::unimplemented_spaceship_operator(); }
                     else { throw bad_any_access("no 'operator<=>' found in current type"); }
                 }
-                return result.cmp;
+                return m_vtable_->cmp(*this, other);
             }
         }
 
@@ -245,7 +227,7 @@ namespace gold {
         /// friend holds_current_type
         template <typename T>
         friend constexpr bool holds_current_type(const view_any& op) noexcept {
-            return op.type_info() == gold::ctype_id<T>();
+            return op.m_vtable_ != nullptr && op.m_vtable_->tinfo == gold::ctype_id<T>();
         }
 
         /// friend any_cast
@@ -0,0 +1,430 @@
+// <gold/bits/coroutine/async_generator.hpp> - gold++ library
+
+// Copyright (C) [ 2021 - 2024 ] - present Desmond Gold
+
+// note: internal header
+
+#pragma once
+#ifndef __GOLD_BITS_CORO_ASYNC_GENERATOR_HPP
+#define __GOLD_BITS_CORO_ASYNC_GENERATOR_HPP
+
+#include <array>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <gold/bits/assume.hpp>
+#include <gold/bits/coroutine/generator.hpp>
+#include <gold/bits/coroutine/promise_allocator.hpp>
+
+namespace gold {
+
+    /// async_generator [fwd]
+    template <typename R, typename V = void, typename Alloc = void, std::size_t Prefetch = 0>
+        requires __coro::viable_generator_params<R, V, Alloc>
+    class async_generator;
+
+    namespace __coro {
+
+        /// __coro::async_gen_promise_base
+        // the body of an 'async_generator' may 'co_await' anything; 'co_yield'
+        // hands the element to the consumer, which resumes the body again
+        // when it awaits the next increment
+        template <typename Yielded, typename Value, std::size_t Prefetch>
+        class async_gen_promise_base {
+          private:
+            template <typename R, typename V, typename Alloc, std::size_t N>
+                requires viable_generator_params<R, V, Alloc>
+            friend class gold::async_generator;
+
+            std::add_pointer_t<Yielded> m_ptr_ = nullptr;
+            std::coroutine_handle<>     m_consumer_;
+            std::exception_ptr          m_except_;
+
+            /// yield_awaiter [ back to the consumer ]
+            struct yield_awaiter {
+                [[nodiscard]] bool await_ready() const noexcept { return false; }
+
+                template <typename Promise>
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> producer) noexcept {
+                    return producer.promise().m_consumer_;
+                }
+
+                void await_resume() const noexcept {}
+            };
+
+            /// element_awaiter [ holds a copy of an lvalue yielded as an rvalue reference ]
+            struct element_awaiter : yield_awaiter {
+                std::remove_cvref_t<Yielded> m_val_;
+
+                template <typename Promise>
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> producer) noexcept {
+                    producer.promise().m_ptr_ = std::addressof(m_val_);
+                    return producer.promise().m_consumer_;
+                }
+            };
+
+            /// mf_advance_ [ what the consumer transfers to; the body, which runs to its next yield ]
+            std::coroutine_handle<> mf_advance_(std::coroutine_handle<> producer, std::coroutine_handle<> consumer, bool) noexcept {
+                m_consumer_ = consumer;
+                return producer;
+            }
+
+            /// mf_at_end_
+            bool mf_at_end_(std::coroutine_handle<> producer) const noexcept { return producer.done(); }
+
+            /// mf_current_
+            Yielded mf_current_() const noexcept { return static_cast<Yielded>(*m_ptr_); }
+
+            /// mf_check_ [ after every advance; rethrows once the body is done ]
+            void mf_check_(std::coroutine_handle<> producer) {
+                if (producer.done() && m_except_)
+                    std::rethrow_exception(std::exchange(m_except_, nullptr));
+            }
+
+            /// mf_release_ [ the body only runs while the consumer waits, so it is suspended ]
+            void mf_release_(std::coroutine_handle<> producer) noexcept { producer.destroy(); }
+
+          public:
+            std::suspend_always initial_suspend() const noexcept { return {}; }
+
+            [[nodiscard]] yield_awaiter final_suspend() noexcept { return {}; }
+
+            [[nodiscard]] yield_awaiter yield_value(Yielded val) noexcept {
+                m_ptr_ = std::addressof(val);
+                return {};
+            }
+
+            [[nodiscard]] auto yield_value(const std::remove_reference_t<Yielded>& val)
+                noexcept(std::is_nothrow_constructible_v<std::remove_cvref_t<Yielded>,
+                                                         const std::remove_reference_t<Yielded>&>)
+                requires std::is_rvalue_reference_v<Yielded>
+                      && std::constructible_from<std::remove_cvref_t<Yielded>,
+                                                 const std::remove_reference_t<Yielded>&>
+            {
+                return element_awaiter { {}, val };
+            }
+
+            void return_void() noexcept {}
+
+            void unhandled_exception() noexcept { m_except_ = std::current_exception(); }
+        };
+
+        /// __coro::async_gen_promise_base<Prefetch>
+        // the body keeps running after a yield, copying up to 'Prefetch'
+        // elements into a ring, so that it can start its next operation
+        // while the consumer is still busy with an earlier element; it is
+        // parked when the ring is full and restarted by the consumer. a
+        // generator dropped while its body runs leaves the frame to the
+        // body, which destroys it at its next yield or at its end
+        template <typename Yielded, typename Value, std::size_t Prefetch>
+            requires (Prefetch > 0)
+        class async_gen_promise_base<Yielded, Value, Prefetch> {
+          private:
+            template <typename R, typename V, typename Alloc, std::size_t N>
+                requires viable_generator_params<R, V, Alloc>
+            friend class gold::async_generator;
+
+            std::mutex                                m_mtx_;
+            std::array<std::optional<Value>, Prefetch> m_ring_;
+            std::size_t                               m_head_  = 0;
+            std::size_t                               m_count_ = 0;
+            std::coroutine_handle<>                   m_consumer_; // waiting for an element
+            bool                                      m_parked_ = true; // the body is suspended at a yield
+            bool                                      m_done_   = false;
+            bool                                      m_at_end_ = false; // as seen by the consumer
+            bool                                      m_orphan_ = false; // the generator is gone
+            std::exception_ptr                        m_except_;
+
+            /// yield_awaiter
+            struct yield_awaiter {
+                std::optional<Value> m_val_;
+
+                [[nodiscard]] bool await_ready() const noexcept { return false; }
+
+                template <typename Promise>
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> producer) noexcept {
+                    async_gen_promise_base& self = producer.promise();
+                    std::unique_lock lock (self.m_mtx_);
+                    if (self.m_orphan_) {
+                        lock.unlock();
+                        producer.destroy();
+                        return std::noop_coroutine();
+                    }
+                    self.m_ring_[(self.m_head_ + self.m_count_) % Prefetch] = std::move(m_val_);
+                    ++self.m_count_;
+                    auto consumer = std::exchange(self.m_consumer_, nullptr);
+                    if (consumer || self.m_count_ == Prefetch) {
+                        // the consumer restarts the body once it takes an element
+                        self.m_parked_ = true;
+                        return consumer ? consumer : std::noop_coroutine();
+                    }
+                    return producer;
+                }
+
+                void await_resume() const noexcept {}
+            };
+
+            /// final_awaiter
+            struct final_awaiter {
+                [[nodiscard]] bool await_ready() const noexcept { return false; }
+
+                template <typename Promise>
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> producer) noexcept {
+                    async_gen_promise_base& self = producer.promise();
+                    std::unique_lock lock (self.m_mtx_);
+                    if (self.m_orphan_) {
+                        lock.unlock();
+                        producer.destroy();
+                        return std::noop_coroutine();
+                    }
+                    self.m_done_ = true;
+                    // a waiting consumer has seen every element
+                    auto consumer = std::exchange(self.m_consumer_, nullptr);
+                    if (!consumer)
+                        return std::noop_coroutine();
+                    self.m_at_end_ = true;
+                    return consumer;
+                }
+
+                void await_resume() const noexcept {}
+            };
+
+            /// mf_advance_ [ 'pop' releases the element the consumer was looking at ]
+            std::coroutine_handle<> mf_advance_(std::coroutine_handle<> producer, std::coroutine_handle<> consumer, bool pop) {
+                std::unique_lock lock (m_mtx_);
+                if (pop) {
+                    m_ring_[m_head_].reset();
+                    m_head_ = (m_head_ + 1) % Prefetch;
+                    --m_count_;
+                }
+
+                if (m_count_ != 0)
+                    return consumer;
+
+                if (m_done_) {
+                    m_at_end_ = true;
+                    return consumer;
+                }
+
+                m_consumer_ = consumer;
+                if (m_parked_) {
+                    m_parked_ = false;
+                    return producer;
+                }
+                // the body is running elsewhere and resumes the consumer
+                return std::noop_coroutine();
+            }
+
+            bool mf_at_end_(std::coroutine_handle<>) const noexcept { return m_at_end_; }
+
+            Yielded mf_current_() noexcept { return static_cast<Yielded>(*m_ring_[m_head_]); }
+
+            /// mf_check_ [ also restarts a parked body while the ring has room ]
+            void mf_check_(std::coroutine_handle<> producer) {
+                std::unique_lock lock (m_mtx_);
+                if (m_parked_ && !m_done_ && m_count_ != Prefetch) {
+                    // let the body start on what comes next, e.g. issue
+                    // its next read, before the consumer carries on
+                    m_parked_ = false;
+                    lock.unlock();
+                    producer.resume();
+                    return;
+                }
+                if (m_at_end_ && m_except_)
+                    std::rethrow_exception(std::exchange(m_except_, nullptr));
+            }
+
+            /// mf_release_ [ destroys the frame now if the body is suspended ]
+            void mf_release_(std::coroutine_handle<> producer) noexcept {
+                std::unique_lock lock (m_mtx_);
+                if (!m_parked_ && !m_done_) {
+                    // running, or suspended on something other than a yield
+                    m_orphan_ = true;
+                    return;
+                }
+                lock.unlock();
+                producer.destroy();
+            }
+
+          public:
+            std::suspend_always initial_suspend() const noexcept { return {}; }
+
+            [[nodiscard]] final_awaiter final_suspend() noexcept { return {}; }
+
+            [[nodiscard]] yield_awaiter yield_value(Yielded val)
+                noexcept(std::is_nothrow_constructible_v<Value, Yielded>)
+            {
+                return yield_awaiter { std::optional<Value>(std::in_place, static_cast<Yielded>(val)) };
+            }
+
+            [[nodiscard]] yield_awaiter yield_value(const std::remove_reference_t<Yielded>& val)
+                noexcept(std::is_nothrow_constructible_v<Value, const std::remove_reference_t<Yielded>&>)
+                requires std::is_rvalue_reference_v<Yielded>
+                      && std::constructible_from<Value, const std::remove_reference_t<Yielded>&>
+            {
+                return yield_awaiter { std::optional<Value>(std::in_place, val) };
+            }
+
+            void return_void() noexcept {}
+
+            void unhandled_exception() noexcept { m_except_ = std::current_exception(); }
+        };
+
+    } // namespace __coro
+
+    /// async_generator
+    // a generator whose body can 'co_await'; 'begin' and the increment of
+    // its iterator are awaited:
+    //
+    //   for (auto it = co_await gen.begin(); it != gen.end(); co_await ++it)
+    //       use(*it);
+    //
+    // with 'Prefetch' of zero the body runs only while the consumer waits
+    // for the next element and elements are not copied. otherwise the body
+    // keeps going after a yield, keeping up to 'Prefetch' elements (copied
+    // as 'value_type') ahead of the consumer, and the two overlap whenever
+    // the body awaits something that completes elsewhere; if the generator
+    // is destroyed meanwhile, the body goes on to its next yield or to its
+    // end, where the frame is destroyed
+    template <typename R, typename V, typename Alloc, std::size_t Prefetch>
+        requires __coro::viable_generator_params<R, V, Alloc>
+    class async_generator {
+      public:
+        /// async_generator::value_type
+        using value_type   = __coro::gen_value_t<R, V>;
+
+        /// async_generator::reference
+        using reference    = __coro::gen_ref_t<R, V>;
+
+        /// async_generator::yielded_type
+        using yielded_type = __coro::gen_yield_t<reference>;
+
+        /// async_generator::promise_type
+        struct promise_type : __coro::promise_allocator<Alloc>,
+                              __coro::async_gen_promise_base<yielded_type, value_type, Prefetch> {
+
+            [[nodiscard]] async_generator get_return_object() noexcept {
+                return async_generator { __coro::gen_secret_tag{}, handle_type::from_promise(*this) };
+            }
+
+        };
+
+      private:
+        using handle_type = std::coroutine_handle<promise_type>;
+
+      public:
+        /// async_generator::iterator
+        class iterator {
+          private:
+            friend async_generator;
+
+            handle_type m_coro_;
+
+            explicit iterator(__coro::gen_secret_tag, handle_type coro) noexcept
+            : m_coro_(coro) {}
+
+            struct increment_awaiter {
+                iterator* m_iter_;
+
+                [[nodiscard]] bool await_ready() const noexcept { return false; }
+
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<> consumer) {
+                    auto producer = m_iter_->m_coro_;
+                    return producer.promise().mf_advance_(producer, consumer, true);
+                }
+
+                iterator& await_resume() {
+                    m_iter_->m_coro_.promise().mf_check_(m_iter_->m_coro_);
+                    return *m_iter_;
+                }
+            };
+
+          public:
+            using value_type      = async_generator::value_type;
+            using difference_type = std::ptrdiff_t;
+
+            iterator(iterator&& other) noexcept
+            : m_coro_(std::exchange(other.m_coro_, {})) {}
+
+            iterator& operator=(iterator&& other) noexcept {
+                if (this != &other)
+                    m_coro_ = std::exchange(other.m_coro_, {});
+                return *this;
+            }
+
+            [[nodiscard]] reference operator*() const noexcept {
+                gold::assume(!m_coro_.promise().mf_at_end_(m_coro_));
+                return static_cast<reference>(m_coro_.promise().mf_current_());
+            }
+
+            /// operator++ [ to be awaited ]
+            [[nodiscard]] increment_awaiter operator++() noexcept {
+                return increment_awaiter { this };
+            }
+
+            [[nodiscard]] bool operator==(std::default_sentinel_t) const noexcept {
+                return m_coro_.promise().mf_at_end_(m_coro_);
+            }
+        };
+
+      private:
+        handle_type m_coro_ = nullptr;
+
+        explicit async_generator(__coro::gen_secret_tag, handle_type coro) noexcept : m_coro_(coro) {}
+
+        struct begin_awaiter {
+            handle_type m_coro_;
+
+            [[nodiscard]] bool await_ready() const noexcept { return false; }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> consumer) {
+                return m_coro_.promise().mf_advance_(m_coro_, consumer, false);
+            }
+
+            iterator await_resume() {
+                m_coro_.promise().mf_check_(m_coro_);
+                return iterator { __coro::gen_secret_tag{}, m_coro_ };
+            }
+        };
+
+      public:
+        async_generator() noexcept = default;
+
+        async_generator(async_generator&& other) noexcept : m_coro_(std::exchange(other.m_coro_, {})) {}
+
+        ~async_generator() {
+            if (m_coro_)
+                m_coro_.promise().mf_release_(m_coro_);
+        }
+
+        async_generator& operator=(async_generator other) noexcept {
+            swap(other);
+            return *this;
+        }
+
+        /// begin [ to be awaited; pre: not yet begun ]
+        [[nodiscard]] begin_awaiter begin() noexcept {
+            gold::assume(static_cast<bool>(m_coro_));
+            return begin_awaiter { m_coro_ };
+        }
+
+        [[nodiscard]] constexpr std::default_sentinel_t end() const noexcept {
+            return std::default_sentinel;
+        }
+
+        void swap(async_generator& other) noexcept {
+            std::ranges::swap(m_coro_, other.m_coro_);
+        }
+
+        friend void swap(async_generator& lhs, async_generator& rhs) noexcept {
+            lhs.swap(rhs);
+        }
+    };
+
+} // namespace gold
+
+#endif // __GOLD_BITS_CORO_ASYNC_GENERATOR_HPP
@@ -0,0 +1,139 @@
+// <gold/bits/coroutine/async_mutex.hpp> - gold++ library
+
+// Copyright (C) [ 2021 - 2024 ] - present Desmond Gold
+
+// note: internal header
+
+#pragma once
+#ifndef __GOLD_BITS_CORO_ASYNC_MUTEX_HPP
+#define __GOLD_BITS_CORO_ASYNC_MUTEX_HPP
+
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <utility>
+#include <gold/bits/coroutine/async_waiter.hpp>
+
+namespace gold {
+
+    class async_mutex;
+
+    /// async_mutex_lock
+    // owns a lock of an 'async_mutex' and unlocks it when destroyed
+    class [[nodiscard]] async_mutex_lock {
+      private:
+        async_mutex* m_mtx_;
+
+      public:
+        explicit async_mutex_lock(async_mutex& mtx, std::adopt_lock_t) noexcept : m_mtx_(&mtx) {}
+
+        async_mutex_lock(async_mutex_lock&& other) noexcept : m_mtx_(std::exchange(other.m_mtx_, nullptr)) {}
+
+        async_mutex_lock& operator=(const async_mutex_lock&) = delete;
+
+        ~async_mutex_lock();
+    };
+
+    /// async_mutex
+    // a mutex whose 'lock' suspends the awaiting coroutine rather than the
+    // thread. its state is one word: unlocked, locked, or the last of the
+    // waiters pushed onto a lock-free stack. 'unlock' hands the lock
+    // straight to the longest waiting coroutine and resumes it on the
+    // calling thread
+    class async_mutex {
+      private:
+        /// s_unlocked_ [ any other value means locked ]
+        static constexpr std::uintptr_t s_unlocked_ = 1;
+
+        // newest waiter first, pushed by 'lock' without a lock
+        std::atomic<std::uintptr_t> m_state_ { s_unlocked_ };
+
+        // oldest waiter first, only touched by the owner
+        __coro::async_waiter* m_waiters_ = nullptr;
+
+        /// lock_awaiter
+        class lock_awaiter : protected __coro::async_waiter {
+          protected:
+            async_mutex* m_mtx_;
+
+          public:
+            explicit lock_awaiter(async_mutex& mtx) noexcept : m_mtx_(&mtx) {}
+
+            [[nodiscard]] bool await_ready() const noexcept { return m_mtx_->try_lock(); }
+
+            bool await_suspend(std::coroutine_handle<> coro) noexcept {
+                m_coro_ = coro;
+                std::uintptr_t old = m_mtx_->m_state_.load(std::memory_order_relaxed);
+                for (;;) {
+                    if (old == s_unlocked_) {
+                        if (m_mtx_->m_state_.compare_exchange_weak(old, 0, std::memory_order_acquire, std::memory_order_relaxed))
+                            return false;
+                    } else {
+                        m_next_ = reinterpret_cast<__coro::async_waiter*>(old);
+                        if (m_mtx_->m_state_.compare_exchange_weak(old, reinterpret_cast<std::uintptr_t>(
+                                static_cast<__coro::async_waiter*>(this)), std::memory_order_release, std::memory_order_relaxed))
+                            return true;
+                    }
+                }
+            }
+
+            void await_resume() const noexcept {}
+        };
+
+        /// scoped_lock_awaiter
+        class scoped_lock_awaiter : public lock_awaiter {
+          public:
+            using lock_awaiter::lock_awaiter;
+
+            async_mutex_lock await_resume() const noexcept { return async_mutex_lock(*this->m_mtx_, std::adopt_lock); }
+        };
+
+      public:
+        async_mutex() noexcept = default;
+        async_mutex(const async_mutex&) = delete;
+        async_mutex& operator=(const async_mutex&) = delete;
+
+        /// try_lock
+        [[nodiscard]] bool try_lock() noexcept {
+            std::uintptr_t expected = s_unlocked_;
+            return m_state_.compare_exchange_strong(expected, 0, std::memory_order_acquire, std::memory_order_relaxed);
+        }
+
+        /// lock [ 'co_await' returns once the lock is owned ]
+        [[nodiscard]] lock_awaiter lock() noexcept { return lock_awaiter(*this); }
+
+        /// scoped_lock [ 'co_await' yields an 'async_mutex_lock' ]
+        [[nodiscard]] scoped_lock_awaiter scoped_lock() noexcept { return scoped_lock_awaiter(*this); }
+
+        /// unlock [ pre: locked by the caller ]
+        void unlock() {
+            __coro::async_waiter* next = m_waiters_;
+            if (next == nullptr) {
+                std::uintptr_t expected = 0;
+                if (m_state_.compare_exchange_strong(expected, s_unlocked_, std::memory_order_release, std::memory_order_relaxed))
+                    return;
+
+                // waiters arrived: take the stack, leaving the mutex locked,
+                // and reverse it into arrival order
+                std::uintptr_t stack = m_state_.exchange(0, std::memory_order_acquire);
+                auto* cur = reinterpret_cast<__coro::async_waiter*>(stack);
+                while (cur != nullptr) {
+                    __coro::async_waiter* following = cur->m_next_;
+                    cur->m_next_ = next;
+                    next = cur;
+                    cur = following;
+                }
+            }
+            m_waiters_ = next->m_next_;
+            __coro::resume_waiter(*next);
+        }
+    };
+
+    inline async_mutex_lock::~async_mutex_lock() {
+        if (m_mtx_ != nullptr)
+            m_mtx_->unlock();
+    }
+
+} // namespace gold
+
+#endif // __GOLD_BITS_CORO_ASYNC_MUTEX_HPP
@@ -0,0 +1,92 @@
+// <gold/bits/coroutine/async_semaphore.hpp> - gold++ library
+
+// Copyright (C) [ 2021 - 2024 ] - present Desmond Gold
+
+// note: internal header
+
+#pragma once
+#ifndef __GOLD_BITS_CORO_ASYNC_SEMAPHORE_HPP
+#define __GOLD_BITS_CORO_ASYNC_SEMAPHORE_HPP
+
+#include <coroutine>
+#include <cstddef>
+#include <mutex>
+#include <gold/bits/coroutine/async_waiter.hpp>
+
+namespace gold {
+
+    /// async_semaphore
+    // a counting semaphore whose 'acquire' suspends the awaiting coroutine
+    // rather than the thread; 'release' hands its units to the waiters in
+    // the order they came and resumes them on the calling thread. the lock
+    // inside only guards the count and the queue
+    class async_semaphore {
+      private:
+        std::mutex           m_mtx_;
+        std::ptrdiff_t       m_count_;
+        __coro::waiter_queue m_waiters_;
+
+        /// acquire_awaiter
+        class acquire_awaiter : private __coro::async_waiter {
+          private:
+            async_semaphore* m_sem_;
+
+          public:
+            explicit acquire_awaiter(async_semaphore& sem) noexcept : m_sem_(&sem) {}
+
+            [[nodiscard]] bool await_ready() const noexcept { return m_sem_->try_acquire(); }
+
+            bool await_suspend(std::coroutine_handle<> coro) {
+                m_coro_ = coro;
+                std::lock_guard guard (m_sem_->m_mtx_);
+                if (m_sem_->m_count_ > 0) {
+                    --m_sem_->m_count_;
+                    return false;
+                }
+                m_sem_->m_waiters_.push_back(*this);
+                return true;
+            }
+
+            void await_resume() const noexcept {}
+        };
+
+      public:
+        explicit async_semaphore(std::ptrdiff_t initial = 0) noexcept : m_count_(initial) {}
+        async_semaphore(const async_semaphore&) = delete;
+        async_semaphore& operator=(const async_semaphore&) = delete;
+
+        /// try_acquire
+        [[nodiscard]] bool try_acquire() {
+            std::lock_guard guard (m_mtx_);
+            if (m_count_ <= 0)
+                return false;
+            --m_count_;
+            return true;
+        }
+
+        /// acquire [ 'co_await' returns once a unit is taken ]
+        [[nodiscard]] acquire_awaiter acquire() noexcept { return acquire_awaiter(*this); }
+
+        /// release [ adds 'n' units, waking up to 'n' waiters ]
+        void release(std::ptrdiff_t n = 1) {
+            __coro::waiter_queue woken;
+            {
+                std::lock_guard guard (m_mtx_);
+                for (; n > 0 && !m_waiters_.empty(); --n)
+                    woken.push_back(m_waiters_.pop_front());
+                m_count_ += n;
+            }
+            while (!woken.empty())
+                __coro::resume_waiter(woken.pop_front());
+        }
+
+        /// available [ a snapshot ]
+        [[nodiscard]] std::ptrdiff_t available() {
+            std::lock_guard guard (m_mtx_);
+            return m_count_;
+        }
+    };
+
+} // namespace gold
+
+#endif // __GOLD_BITS_CORO_ASYNC_SEMAPHORE_HPP
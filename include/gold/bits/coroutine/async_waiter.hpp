@@ -0,0 +1,84 @@
+// <gold/bits/coroutine/async_waiter.hpp> - gold++ library
+
+// Copyright (C) [ 2021 - 2024 ] - present Desmond Gold
+
+// note: internal header
+
+#pragma once
+#ifndef __GOLD_BITS_CORO_ASYNC_WAITER_HPP
+#define __GOLD_BITS_CORO_ASYNC_WAITER_HPP
+
+#include <coroutine>
+
+namespace gold::__coro {
+
+    /// __coro::async_waiter
+    // a coroutine suspended on an 'async_mutex', 'async_semaphore' or
+    // 'channel'; it lives in the awaiter, inside the frame, until resumed
+    struct async_waiter {
+        async_waiter*           m_next_ = nullptr;
+        std::coroutine_handle<> m_coro_;
+    };
+
+    /// __coro::waiter_queue [ intrusive, first in first out ]
+    class waiter_queue {
+      private:
+        async_waiter* m_head_ = nullptr;
+        async_waiter* m_tail_ = nullptr;
+
+      public:
+        [[nodiscard]] bool empty() const noexcept { return m_head_ == nullptr; }
+
+        void push_back(async_waiter& w) noexcept {
+            w.m_next_ = nullptr;
+            if (m_tail_ != nullptr)
+                m_tail_->m_next_ = &w;
+            else
+                m_head_ = &w;
+            m_tail_ = &w;
+        }
+
+        /// pop_front [ pre: not empty ]
+        async_waiter& pop_front() noexcept {
+            async_waiter& result = *m_head_;
+            m_head_ = result.m_next_;
+            if (m_head_ == nullptr)
+                m_tail_ = nullptr;
+            return result;
+        }
+
+        /// take [ leaves the queue empty ]
+        waiter_queue take() noexcept {
+            waiter_queue result = *this;
+            m_head_ = m_tail_ = nullptr;
+            return result;
+        }
+    };
+
+    /// __coro::resume_waiter
+    // resumes the coroutine of 'w'. a waiter handed over while another
+    // one is being resumed on the same thread, e.g. by a coroutine
+    // unlocking a mutex right after it got it, is queued and resumed once
+    // that one suspends, so chains of handovers run in a loop instead of
+    // growing the stack
+    inline void resume_waiter(async_waiter& w) {
+        struct trampoline {
+            waiter_queue m_queue_;
+            bool         m_active_ = false;
+        };
+        static thread_local constinit trampoline t_trampoline;
+
+        t_trampoline.m_queue_.push_back(w);
+        if (t_trampoline.m_active_)
+            return;
+
+        t_trampoline.m_active_ = true;
+        while (!t_trampoline.m_queue_.empty())
+            // the waiter is gone once its coroutine runs
+            t_trampoline.m_queue_.pop_front().m_coro_.resume();
+        t_trampoline.m_active_ = false;
+    }
+
+} // namespace gold::__coro
+
+#endif // __GOLD_BITS_CORO_ASYNC_WAITER_HPP
@@ -10,6 +10,7 @@
 
 #include <concepts>
 #include <coroutine>
+#include <utility>
 #include <gold/bits/type_traits/type_relationships.hpp>
 #include <gold/bits/type_traits/specialization_of.hpp>
 
@@ -54,6 +55,25 @@ namespace gold {
                      || __coro::has_adl_co_await<T, Promise>
                      || simple_awaitable<T, Promise>;
 
+    namespace __coro {
+
+        /// __coro::get_awaiter [ the object whose 'await_*' members 'co_await t' calls ]
+        template <typename T>
+        decltype(auto) get_awaiter(T&& t) {
+            if constexpr (__coro::has_member_co_await<T>)
+                return std::forward<T>(t).operator co_await();
+            else if constexpr (__coro::has_adl_co_await<T>)
+                return operator co_await(std::forward<T>(t));
+            else
+                return static_cast<T&&>(t);
+        }
+
+        /// __coro::await_result_t
+        template <typename T>
+        using await_result_t = decltype(std::declval<decltype(__coro::get_awaiter(std::declval<T>()))&>().await_resume());
+
+    } // namespace __coro
+
 } // namespace gold
 
 #endif // __GOLD_BITS_COROUTINE_AWAITABLE_HPP
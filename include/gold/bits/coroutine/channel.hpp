@@ -0,0 +1,209 @@
+// <gold/bits/coroutine/channel.hpp> - gold++ library
+
+// Copyright (C) [ 2021 - 2024 ] - present Desmond Gold
+
+// note: internal header
+
+#pragma once
+#ifndef __GOLD_BITS_CORO_CHANNEL_HPP
+#define __GOLD_BITS_CORO_CHANNEL_HPP
+
+#include <concepts>
+#include <coroutine>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <gold/bits/coroutine/async_waiter.hpp>
+
+namespace gold {
+
+    /// channel
+    // a queue of up to 'Capacity' values between any number of sending
+    // and receiving coroutines. 'send' suspends while the queue is full and
+    // 'receive' while it is empty; a value sent while a receiver waits is
+    // handed to it directly, so a channel of capacity 0 is a rendezvous.
+    // waiters are resumed on the thread of whoever lets them through
+    //
+    // after 'close', 'send' fails and 'receive' drains what is left, then
+    // yields nothing; coroutines waiting at that point are resumed
+    template <typename T, std::size_t Capacity = 0>
+        requires std::same_as<T, std::remove_cv_t<T>> && std::is_object_v<T> && std::move_constructible<T>
+    class channel {
+      private:
+        /// send_awaiter [ yields false if the channel was closed; the value is dropped ]
+        class send_awaiter : private __coro::async_waiter {
+          private:
+            friend channel;
+
+            channel* m_chan_;
+            T        m_value_;
+            bool     m_sent_ = false;
+
+          public:
+            send_awaiter(channel& chan, T&& value) noexcept(std::is_nothrow_move_constructible_v<T>)
+            : m_chan_(&chan), m_value_(std::move(value)) {}
+
+            [[nodiscard]] bool await_ready() const noexcept { return false; }
+
+            bool await_suspend(std::coroutine_handle<> coro) {
+                m_coro_ = coro;
+                return m_chan_->mf_send_(*this);
+            }
+
+            bool await_resume() const noexcept { return m_sent_; }
+        };
+
+        /// receive_awaiter [ yields nothing once the channel is closed and empty ]
+        class receive_awaiter : private __coro::async_waiter {
+          private:
+            friend channel;
+
+            channel*         m_chan_;
+            std::optional<T> m_value_;
+
+          public:
+            explicit receive_awaiter(channel& chan) noexcept : m_chan_(&chan) {}
+
+            [[nodiscard]] bool await_ready() const noexcept { return false; }
+
+            bool await_suspend(std::coroutine_handle<> coro) {
+                m_coro_ = coro;
+                return m_chan_->mf_receive_(*this, true);
+            }
+
+            std::optional<T> await_resume() noexcept(std::is_nothrow_move_constructible_v<T>) {
+                return std::move(m_value_);
+            }
+        };
+
+        std::mutex           m_mtx_;
+        union { T m_buf_[Capacity == 0 ? 1 : Capacity]; };
+        std::size_t          m_head_   = 0;
+        std::size_t          m_size_   = 0;
+        bool                 m_closed_ = false;
+        __coro::waiter_queue m_senders_;   // only while the buffer is full
+        __coro::waiter_queue m_receivers_; // only while the buffer is empty
+
+        void mf_push_(T&& value) {
+            std::construct_at(m_buf_ + (m_head_ + m_size_) % Capacity, std::move(value));
+            ++m_size_;
+        }
+
+        T mf_pop_() {
+            T& slot = m_buf_[m_head_];
+            T result = std::move(slot);
+            std::destroy_at(&slot);
+            m_head_ = (m_head_ + 1) % Capacity;
+            --m_size_;
+            return result;
+        }
+
+        /// mf_send_ [ true if 'op' has to wait ]
+        bool mf_send_(send_awaiter& op) {
+            std::unique_lock lock (m_mtx_);
+            if (m_closed_)
+                return false;
+            if (!m_receivers_.empty()) {
+                auto& receiver = static_cast<receive_awaiter&>(m_receivers_.pop_front());
+                lock.unlock();
+                receiver.m_value_.emplace(std::move(op.m_value_));
+                op.m_sent_ = true;
+                __coro::resume_waiter(receiver);
+                return false;
+            }
+            if constexpr (Capacity > 0) {
+                if (m_size_ < Capacity) {
+                    this->mf_push_(std::move(op.m_value_));
+                    op.m_sent_ = true;
+                    return false;
+                }
+            }
+            m_senders_.push_back(op);
+            return true;
+        }
+
+        /// mf_receive_ [ true if 'op' has to wait, which it only does if 'wait' ]
+        bool mf_receive_(receive_awaiter& op, bool wait) {
+            std::unique_lock lock (m_mtx_);
+            if constexpr (Capacity > 0) {
+                if (m_size_ != 0) {
+                    op.m_value_.emplace(this->mf_pop_());
+                    // the longest waiting sender takes the freed slot
+                    if (!m_senders_.empty()) {
+                        auto& sender = static_cast<send_awaiter&>(m_senders_.pop_front());
+                        this->mf_push_(std::move(sender.m_value_));
+                        sender.m_sent_ = true;
+                        lock.unlock();
+                        __coro::resume_waiter(sender);
+                    }
+                    return false;
+                }
+            }
+            if (!m_senders_.empty()) {
+                auto& sender = static_cast<send_awaiter&>(m_senders_.pop_front());
+                lock.unlock();
+                op.m_value_.emplace(std::move(sender.m_value_));
+                sender.m_sent_ = true;
+                __coro::resume_waiter(sender);
+                return false;
+            }
+            if (m_closed_ || !wait)
+                return false;
+            m_receivers_.push_back(op);
+            return true;
+        }
+
+      public:
+        channel() noexcept {}
+        channel(const channel&) = delete;
+        channel& operator=(const channel&) = delete;
+
+        /// destructor [ pre: no coroutine waits on the channel ]
+        ~channel() {
+            if constexpr (Capacity > 0)
+                while (m_size_ != 0)
+                    this->mf_pop_();
+        }
+
+        /// send [ 'co_await' yields whether the value went through ]
+        [[nodiscard]] send_awaiter send(T value) noexcept(std::is_nothrow_move_constructible_v<T>) {
+            return send_awaiter(*this, std::move(value));
+        }
+
+        /// receive [ 'co_await' yields the next value, or nothing once closed and drained ]
+        [[nodiscard]] receive_awaiter receive() noexcept { return receive_awaiter(*this); }
+
+        /// try_receive [ a value if one is ready ]
+        std::optional<T> try_receive() {
+            receive_awaiter op (*this);
+            this->mf_receive_(op, false);
+            return std::move(op.m_value_);
+        }
+
+        /// close [ idempotent ]
+        void close() {
+            __coro::waiter_queue senders, receivers;
+            {
+                std::lock_guard guard (m_mtx_);
+                m_closed_ = true;
+                senders   = m_senders_.take();
+                receivers = m_receivers_.take();
+            }
+            while (!senders.empty())
+                __coro::resume_waiter(senders.pop_front());
+            while (!receivers.empty())
+                __coro::resume_waiter(receivers.pop_front());
+        }
+
+        /// closed
+        [[nodiscard]] bool closed() {
+            std::lock_guard guard (m_mtx_);
+            return m_closed_;
+        }
+    };
+
+} // namespace gold
+
+#endif // __GOLD_BITS_CORO_CHANNEL_HPP
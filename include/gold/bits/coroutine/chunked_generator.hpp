@@ -0,0 +1,315 @@
+// <gold/bits/coroutine/chunked_generator.hpp> - gold++ library
+
+// Copyright (C) [ 2021 - 2024 ] - present Desmond Gold
+
+// note: internal header
+
+#pragma once
+#ifndef __GOLD_BITS_CORO_CHUNKED_GENERATOR_HPP
+#define __GOLD_BITS_CORO_CHUNKED_GENERATOR_HPP
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <gold/bits/assume.hpp>
+#include <gold/bits/coroutine/generator.hpp>
+#include <gold/bits/coroutine/promise_allocator.hpp>
+#include <gold/bits/coroutine/yieldable.hpp>
+
+namespace gold {
+
+    /// chunked_generator [fwd]
+    template <typename T, std::size_t N = 64, typename Alloc = void>
+        requires std::same_as<T, std::remove_cv_t<T>> && std::is_object_v<T> && std::movable<T> && (N > 0)
+    class chunked_generator;
+
+    namespace __coro {
+
+        /// __coro::chunk_yieldable
+        // ranges whose elements the consumer can walk in place
+        template <typename R, typename T>
+        concept chunk_yieldable =
+            std::ranges::contiguous_range<R> && std::ranges::sized_range<R> &&
+            std::same_as<std::remove_cv_t<std::ranges::range_value_t<R>>, T>;
+
+        /// __coro::chunk_by_value
+        // elements yielded by value: passed in registers, they are stored
+        // straight into the buffer; a reference would make the compiler
+        // spill the 'co_yield' operand into the frame and read it back
+        template <typename T>
+        concept chunk_by_value = std::is_trivially_copyable_v<T> && sizeof(T) <= 2 * sizeof(void*);
+
+        /// __coro::chunked_promise_base
+        // 'co_yield' of an element stores it in a buffer inside the promise
+        // and suspends only once the buffer is full; the consumer walks the
+        // buffer before resuming the body again. 'co_yield' of a contiguous
+        // range through 'ranges::to_yieldable' lends the range itself
+        template <typename T, std::size_t N>
+        class chunked_promise_base {
+          private:
+            template <typename U, std::size_t M, typename Alloc>
+                requires std::same_as<U, std::remove_cv_t<U>> && std::is_object_v<U> && std::movable<U> && (M > 0)
+            friend class gold::chunked_generator;
+
+            union { T m_buf_[N]; };
+            std::size_t        m_size_    = 0;
+            const T*           m_first_   = nullptr; // the chunk handed to the consumer
+            const T*           m_last_    = nullptr;
+            const T*           m_pending_first_ = nullptr; // a lent range behind the buffer
+            const T*           m_pending_last_  = nullptr;
+            std::exception_ptr m_except_;
+
+            /// mf_publish_ [ hands the buffer to the consumer ]
+            void mf_publish_() noexcept {
+                m_first_ = m_buf_;
+                m_last_  = m_buf_ + m_size_;
+            }
+
+            /// mf_clear_ [ the consumer is done with the buffer ]
+            void mf_clear_() noexcept {
+                std::destroy_n(m_buf_, m_size_);
+                m_size_ = 0;
+            }
+
+            /// element_awaiter
+            struct element_awaiter {
+                chunked_promise_base* m_promise_;
+
+                [[nodiscard]] bool await_ready() const noexcept { return m_promise_->m_size_ != N; }
+
+                void await_suspend(std::coroutine_handle<>) const noexcept { m_promise_->mf_publish_(); }
+
+                void await_resume() const noexcept {
+                    if (m_promise_->m_size_ == N)
+                        m_promise_->mf_clear_();
+                }
+            };
+
+            /// range_awaiter
+            struct range_awaiter {
+                chunked_promise_base* m_promise_;
+                const T*              m_first_;
+                const T*              m_last_;
+
+                [[nodiscard]] bool await_ready() const noexcept { return m_first_ == m_last_; }
+
+                void await_suspend(std::coroutine_handle<>) const noexcept {
+                    chunked_promise_base& self = *m_promise_;
+                    if (self.m_size_ == 0) {
+                        self.m_first_ = m_first_;
+                        self.m_last_  = m_last_;
+                    } else {
+                        self.mf_publish_();
+                        self.m_pending_first_ = m_first_;
+                        self.m_pending_last_  = m_last_;
+                    }
+                }
+
+                void await_resume() const noexcept {
+                    if (m_first_ != m_last_)
+                        m_promise_->mf_clear_();
+                }
+            };
+
+            /// final_awaiter [ what is left in the buffer goes last ]
+            struct final_awaiter {
+                chunked_promise_base* m_promise_;
+
+                [[nodiscard]] bool await_ready() const noexcept { return false; }
+
+                void await_suspend(std::coroutine_handle<>) const noexcept { m_promise_->mf_publish_(); }
+
+                void await_resume() const noexcept {}
+            };
+
+          public:
+            chunked_promise_base() noexcept {}
+
+            ~chunked_promise_base() { std::destroy_n(m_buf_, m_size_); }
+
+            std::suspend_always initial_suspend() const noexcept { return {}; }
+
+            [[nodiscard]] final_awaiter final_suspend() noexcept { return { this }; }
+
+            [[nodiscard]] element_awaiter yield_value(T val) noexcept requires chunk_by_value<T> {
+                std::construct_at(m_buf_ + m_size_, val);
+                ++m_size_;
+                return { this };
+            }
+
+            [[nodiscard]] element_awaiter yield_value(const T& val)
+                noexcept(std::is_nothrow_copy_constructible_v<T>) requires std::copy_constructible<T> && (!chunk_by_value<T>)
+            {
+                std::construct_at(m_buf_ + m_size_, val);
+                ++m_size_;
+                return { this };
+            }
+
+            [[nodiscard]] element_awaiter yield_value(T&& val)
+                noexcept(std::is_nothrow_move_constructible_v<T>) requires (!chunk_by_value<T>)
+            {
+                std::construct_at(m_buf_ + m_size_, std::move(val));
+                ++m_size_;
+                return { this };
+            }
+
+            /// yield_value [ the range must outlive the 'co_yield' expression ]
+            template <chunk_yieldable<T> R, typename Alloc>
+            [[nodiscard]] range_awaiter yield_value(ranges::yieldable_view<R, Alloc> elem) noexcept {
+                const T* first = std::ranges::data(elem.range);
+                return { this, first, first + std::ranges::size(elem.range) };
+            }
+
+            void await_transform(auto&&...) = delete;
+
+            void return_void() noexcept {}
+
+            // rethrown once the consumer has seen every element before it
+            void unhandled_exception() noexcept { m_except_ = std::current_exception(); }
+        };
+
+    } // namespace __coro
+
+    /// chunked_generator
+    // a generator of small elements, e.g. bytes or tokens, that pays for a
+    // suspension once per 'N' elements instead of once per element; the
+    // body runs up to 'N' elements ahead of the consumer
+    template <typename T, std::size_t N, typename Alloc>
+        requires std::same_as<T, std::remove_cv_t<T>> && std::is_object_v<T> && std::movable<T> && (N > 0)
+    class chunked_generator : public std::ranges::view_interface<chunked_generator<T, N, Alloc>> {
+      public:
+        /// chunked_generator::value_type
+        using value_type = T;
+
+        /// chunked_generator::reference
+        using reference  = const T&;
+
+        /// chunked_generator::promise_type
+        struct promise_type : __coro::promise_allocator<Alloc>,
+                              __coro::chunked_promise_base<T, N> {
+
+            [[nodiscard]] chunked_generator get_return_object() noexcept {
+                return chunked_generator { __coro::gen_secret_tag{}, handle_type::from_promise(*this) };
+            }
+
+        };
+
+      private:
+        using handle_type = std::coroutine_handle<promise_type>;
+
+        class iterator {
+          private:
+            friend chunked_generator;
+
+            handle_type m_coro_;
+            const T*    m_cur_ = nullptr;
+            const T*    m_end_ = nullptr;
+
+            explicit iterator(__coro::gen_secret_tag, handle_type coro)
+            : m_coro_(coro) { this->mf_refill_(); }
+
+            /// mf_refill_ [ the next non-empty chunk, or none once the body is done ]
+            [[gnu::noinline]] void mf_refill_() {
+                auto& promise = m_coro_.promise();
+                for (;;) {
+                    if (promise.m_pending_first_ != nullptr) {
+                        // the buffer is walked, the lent range is next
+                        m_cur_ = std::exchange(promise.m_pending_first_, nullptr);
+                        m_end_ = std::exchange(promise.m_pending_last_, nullptr);
+                    } else if (!m_coro_.done()) {
+                        m_coro_.resume();
+                        m_cur_ = promise.m_first_;
+                        m_end_ = promise.m_last_;
+                    } else {
+                        m_cur_ = m_end_ = nullptr;
+                        if (promise.m_except_)
+                            std::rethrow_exception(std::exchange(promise.m_except_, nullptr));
+                        return;
+                    }
+                    if (m_cur_ != m_end_)
+                        return;
+                }
+            }
+
+          public:
+            using value_type      = chunked_generator::value_type;
+            using difference_type = std::ptrdiff_t;
+
+            iterator(iterator&& other) noexcept
+            : m_coro_(std::exchange(other.m_coro_, {})),
+              m_cur_(std::exchange(other.m_cur_, nullptr)),
+              m_end_(std::exchange(other.m_end_, nullptr)) {}
+
+            iterator& operator=(iterator&& other) noexcept {
+                if (this != &other) {
+                    m_coro_ = std::exchange(other.m_coro_, {});
+                    m_cur_  = std::exchange(other.m_cur_, nullptr);
+                    m_end_  = std::exchange(other.m_end_, nullptr);
+                }
+                return *this;
+            }
+
+            [[nodiscard]] reference operator*() const noexcept {
+                gold::assume(m_cur_ != m_end_);
+                return *m_cur_;
+            }
+
+            iterator& operator++() {
+                gold::assume(m_cur_ != m_end_);
+                if (++m_cur_ == m_end_) [[unlikely]]
+                    this->mf_refill_();
+                return *this;
+            }
+
+            void operator++(int) { ++*this; }
+
+            [[nodiscard]] bool operator==(std::default_sentinel_t) const noexcept {
+                return m_cur_ == m_end_;
+            }
+        };
+
+        handle_type m_coro_ = nullptr;
+
+        explicit chunked_generator(__coro::gen_secret_tag, handle_type coro) noexcept : m_coro_(coro) {}
+
+      public:
+        chunked_generator() noexcept = default;
+
+        chunked_generator(chunked_generator&& other) noexcept : m_coro_(std::exchange(other.m_coro_, {})) {}
+
+        ~chunked_generator() {
+            if (m_coro_)
+                m_coro_.destroy();
+        }
+
+        chunked_generator& operator=(chunked_generator other) noexcept {
+            swap(other);
+            return *this;
+        }
+
+        [[nodiscard]] iterator begin() {
+            // Pre: m_coro_ is suspended at its initial suspend point
+            gold::assume(static_cast<bool>(m_coro_));
+            return iterator { __coro::gen_secret_tag{}, m_coro_ };
+        }
+
+        [[nodiscard]] constexpr std::default_sentinel_t end() const noexcept {
+            return std::default_sentinel;
+        }
+
+        void swap(chunked_generator& other) noexcept {
+            std::ranges::swap(m_coro_, other.m_coro_);
+        }
+
+        friend void swap(chunked_generator& lhs, chunked_generator& rhs) noexcept {
+            lhs.swap(rhs);
+        }
+
+    };
+
+} // namespace gold
+
+#endif // __GOLD_BITS_CORO_CHUNKED_GENERATOR_HPP
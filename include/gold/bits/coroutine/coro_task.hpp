@@ -13,6 +13,8 @@
 #include <functional>
 
 #include <gold/bits/coroutine/coro_base.hpp>
+#include <gold/bits/coroutine/instrumentation.hpp>
+#include <gold/bits/coroutine/promise_allocator.hpp>
 
 namespace gold {
 
@@ -126,12 +128,19 @@ namespace gold {
 
     /// class definition with reference
     template <typename T>
-    class task<T>::promise_type final {
+    class task<T>::promise_type final
+#ifdef GOLD_COROUTINE_INSTRUMENTATION
+    // allocates the frame, so that the probe learns its size
+    : public __coro::promise_allocator<>
+#endif
+    {
       private:
         /// continuation
         std::coroutine_handle<> m_cont_;
         /// exception pointer
         std::exception_ptr m_except_ = nullptr;
+        /// probe [ empty unless 'GOLD_COROUTINE_INSTRUMENTATION' ]
+        [[no_unique_address]] __coro::frame_probe m_probe_;
         /// value
         std::conditional_t<
             std::is_lvalue_reference_v<value_type>,
@@ -140,16 +149,23 @@ namespace gold {
         > m_value_;
 
       public:
+#ifdef GOLD_COROUTINE_INSTRUMENTATION
+        /// constructor [ the default argument names the coroutine function ]
+        promise_type(std::source_location where_ = std::source_location::current()) noexcept {
+            m_probe_.attach(where_);
+        }
+#endif
+
         /// get_return_object
         task get_return_object() noexcept {
             return task { std::coroutine_handle<promise_type>::from_promise(*this) };
         }
 
         /// initial_suspend
-        std::suspend_always initial_suspend() const noexcept { return {}; }
+        auto initial_suspend() noexcept { return m_probe_.wrap(std::suspend_always{}); }
 
         /// final_suspend
-        auto final_suspend() const noexcept {
+        auto final_suspend() noexcept {
             /// final_awaiter_
             struct final_awaiter_ {
                 bool await_ready() noexcept { return false; }
@@ -160,9 +176,15 @@ namespace gold {
                 void await_resume() noexcept {}
             };
 
-            return final_awaiter_{};
+            return m_probe_.wrap(final_awaiter_{});
         }
 
+#ifdef GOLD_COROUTINE_INSTRUMENTATION
+        /// await_transform
+        template <typename A>
+        auto await_transform(A&& awaitable_) { return m_probe_.transform(std::forward<A>(awaitable_)); }
+#endif
+
         /// set_continuation
         void set_continuation(std::coroutine_handle<> cont_) {
             m_cont_ = cont_;
@@ -193,24 +215,38 @@ namespace gold {
 
     /// void specialization for task
     template <>
-    class task<void>::promise_type final {
+    class task<void>::promise_type final
+#ifdef GOLD_COROUTINE_INSTRUMENTATION
+    // allocates the frame, so that the probe learns its size
+    : public __coro::promise_allocator<>
+#endif
+    {
       private:
         /// continuation
         std::coroutine_handle<> m_cont_;
         /// exception pointer
         std::exception_ptr m_except_ = nullptr;
+        /// probe [ empty unless 'GOLD_COROUTINE_INSTRUMENTATION' ]
+        [[no_unique_address]] __coro::frame_probe m_probe_;
 
       public:
+#ifdef GOLD_COROUTINE_INSTRUMENTATION
+        /// constructor [ the default argument names the coroutine function ]
+        promise_type(std::source_location where_ = std::source_location::current()) noexcept {
+            m_probe_.attach(where_);
+        }
+#endif
+
         /// get_return_object
         task get_return_object() noexcept {
             return task { std::coroutine_handle<promise_type>::from_promise(*this) };
         }
 
         /// initial_suspend
-        std::suspend_always initial_suspend() const noexcept { return {}; }
+        auto initial_suspend() noexcept { return m_probe_.wrap(std::suspend_always{}); }
 
         /// final_suspend
-        auto final_suspend() const noexcept {
+        auto final_suspend() noexcept {
             /// final_awaiter_
             struct final_awaiter_ {
                 bool await_ready() noexcept { return false; }
@@ -221,9 +257,15 @@ namespace gold {
                 void await_resume() noexcept {}
             };
 
-            return final_awaiter_{};
+            return m_probe_.wrap(final_awaiter_{});
         }
 
+#ifdef GOLD_COROUTINE_INSTRUMENTATION
+        /// await_transform
+        template <typename A>
+        auto await_transform(A&& awaitable_) { return m_probe_.transform(std::forward<A>(awaitable_)); }
+#endif
+
         /// set_continuation
         void set_continuation(std::coroutine_handle<> cont_) {
             m_cont_ = cont_;
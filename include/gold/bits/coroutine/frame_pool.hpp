@@ -0,0 +1,93 @@
+// <gold/bits/coroutine/frame_pool.hpp> - gold++ library
+
+// Copyright (C) [ 2021 - 2024 ] - present Desmond Gold
+
+// note: internal header
+
+#pragma once
+#ifndef __GOLD_BITS_CORO_FRAME_POOL_HPP
+#define __GOLD_BITS_CORO_FRAME_POOL_HPP
+
+#include <cstddef>
+#include <type_traits>
+
+namespace gold {
+
+    /// frame_pool_stats
+    struct frame_pool_stats {
+        std::size_t allocations          = 0; // served from a size class
+        std::size_t deallocations        = 0; // returned by the thread that owns the block
+        std::size_t remote_deallocations = 0; // returned by other threads
+        std::size_t large_allocations    = 0; // too large for a size class, forwarded to 'operator new'
+        std::size_t chunks               = 0; // chunks carved into blocks
+        std::size_t bytes_reserved       = 0; // held in chunks
+    };
+
+    namespace __coro {
+
+        /// __coro::frame_pool_allocate [ defined in src/frame_pool.cpp ]
+        void* frame_pool_allocate(std::size_t bytes);
+
+        /// __coro::frame_pool_deallocate [ 'bytes' as given to 'frame_pool_allocate' ]
+        void frame_pool_deallocate(void* ptr, std::size_t bytes) noexcept;
+
+        /// __coro::frame_pool_thread_stats
+        frame_pool_stats frame_pool_thread_stats() noexcept;
+
+        /// __coro::frame_pool_global_stats
+        frame_pool_stats frame_pool_global_stats() noexcept;
+
+    } // namespace __coro
+
+    /// frame_pool_allocator
+    // a stateless allocator meant for coroutine frames, e.g. as the 'Alloc'
+    // of 'lazy' or 'generator'. each thread keeps free lists bucketed by
+    // size, carved from 64 KiB chunks that belong to it; a block freed by
+    // another thread is pushed onto a lock-free list of the owning thread
+    // and picked up by it on its next allocation of that size. requests
+    // above 2 KiB go to 'operator new'
+    //
+    // defining 'GOLD_COROUTINE_FRAME_POOL' makes it the allocator used by
+    // coroutines that do not name one. the macro must be the same for the
+    // whole program, library sources included: the choice is made in an
+    // inline 'operator new', and translation units that disagree break the
+    // one definition rule
+    template <typename T = std::byte>
+    class frame_pool_allocator {
+      public:
+        using value_type      = T;
+        using size_type       = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using is_always_equal = std::true_type;
+        using propagate_on_container_move_assignment = std::true_type;
+
+        constexpr frame_pool_allocator() noexcept = default;
+
+        template <typename U>
+        constexpr frame_pool_allocator(const frame_pool_allocator<U>&) noexcept {}
+
+        [[nodiscard]] T* allocate(std::size_t n) {
+            static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+                          "gold::frame_pool_allocator: over-aligned types are not supported");
+            return static_cast<T*>(__coro::frame_pool_allocate(n * sizeof(T)));
+        }
+
+        void deallocate(T* ptr, std::size_t n) noexcept {
+            __coro::frame_pool_deallocate(ptr, n * sizeof(T));
+        }
+
+        /// thread_stats [ of the calling thread's pool ]
+        static frame_pool_stats thread_stats() noexcept { return __coro::frame_pool_thread_stats(); }
+
+        /// global_stats [ summed over every pool, including those of exited threads ]
+        static frame_pool_stats global_stats() noexcept { return __coro::frame_pool_global_stats(); }
+
+        template <typename U>
+        friend constexpr bool operator==(const frame_pool_allocator&, const frame_pool_allocator<U>&) noexcept {
+            return true;
+        }
+    };
+
+} // namespace gold
+
+#endif // __GOLD_BITS_CORO_FRAME_POOL_HPP
@@ -0,0 +1,252 @@
+// <gold/bits/coroutine/instrumentation.hpp> - gold++ library
+
+// Copyright (C) [ 2021 - 2024 ] - present Desmond Gold
+
+// note: internal header
+
+#pragma once
+#ifndef __GOLD_BITS_CORO_INSTRUMENTATION_HPP
+#define __GOLD_BITS_CORO_INSTRUMENTATION_HPP
+
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <source_location>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef GOLD_COROUTINE_INSTRUMENTATION
+# include <atomic>
+# include <gold/bits/coroutine/awaitable.hpp>
+#endif
+
+namespace gold {
+
+    /// coroutine_frame_stats [ one live frame ]
+    struct coroutine_frame_stats {
+        std::source_location     where;          // the coroutine function
+        std::size_t              frame_size = 0; // zero if the allocation was elided
+        std::uint64_t            resumes    = 0;
+        std::chrono::nanoseconds running    {};
+        std::chrono::nanoseconds suspended  {};  // including the current suspension
+        bool                     is_suspended = false;
+    };
+
+    /// coroutine_site_stats [ every frame of one coroutine function, live or not ]
+    struct coroutine_site_stats {
+        std::source_location     where;
+        std::size_t              created    = 0;
+        std::size_t              live       = 0;
+        std::size_t              live_bytes = 0;
+        std::uint64_t            resumes    = 0;
+        std::chrono::nanoseconds running    {};
+        std::chrono::nanoseconds suspended  {};
+    };
+
+    /// coroutine_instrumentation
+    // what 'task' and 'lazy' frames record when 'GOLD_COROUTINE_INSTRUMENTATION'
+    // is defined: the coroutine function that created them, how often they
+    // were resumed, and how long they ran and stayed suspended. time spent
+    // in a coroutine called through symmetric transfer counts for both
+    //
+    // without the macro the frames carry nothing and every report is
+    // empty. the macro must be the same for the whole program, library
+    // sources included
+    class coroutine_instrumentation {
+      public:
+        /// enabled
+#ifdef GOLD_COROUTINE_INSTRUMENTATION
+        static constexpr bool enabled = true;
+#else
+        static constexpr bool enabled = false;
+#endif
+
+        /// live_frames [ a snapshot, longest suspended first ]
+        static std::vector<coroutine_frame_stats> live_frames();
+
+        /// sites [ a snapshot, longest running first ]
+        static std::vector<coroutine_site_stats> sites();
+
+        /// report
+        // the 'n' sites that ran the longest and the 'n' live frames that
+        // have been suspended the longest, written through 'gold::format'
+        static std::string report(std::size_t n = 20);
+    };
+
+    namespace __coro {
+
+#ifdef GOLD_COROUTINE_INSTRUMENTATION
+
+        /// __coro::t_last_frame_ [ set by 'promise_allocator', read by 'frame_probe::attach' ]
+        struct last_frame {
+            const void* m_ptr_  = nullptr;
+            std::size_t m_size_ = 0;
+        };
+
+        inline thread_local constinit last_frame t_last_frame_;
+
+        /// __coro::note_frame
+        inline void note_frame(const void* ptr, std::size_t size) noexcept {
+            t_last_frame_ = { ptr, size };
+        }
+
+        /// __coro::probe_now [ nanoseconds on the steady clock ]
+        inline std::int64_t probe_now() noexcept {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        template <typename Awaiter>
+        class probed_awaiter;
+
+        /// __coro::frame_probe
+        // lives in the promise; linked into a registry while the frame is
+        // alive and folded into the totals of its site when it is destroyed.
+        // counters are written by whichever thread runs the coroutine and
+        // read by reports at any time
+        class frame_probe {
+          private:
+            template <typename>
+            friend class probed_awaiter;
+
+            friend class gold::coroutine_instrumentation;
+
+            frame_probe*               m_prev_ = nullptr; // registry links, under its lock
+            frame_probe*               m_next_ = nullptr;
+            std::source_location       m_where_;
+            std::size_t                m_frame_size_ = 0;
+            bool                       m_attached_   = false;
+            std::atomic<std::uint64_t> m_resumes_      { 0 };
+            std::atomic<std::int64_t>  m_running_      { 0 };
+            std::atomic<std::int64_t>  m_suspended_    { 0 };
+            std::atomic<std::int64_t>  m_stamp_        { 0 }; // the last suspension or resumption
+            std::atomic<bool>          m_is_suspended_ { true };
+
+            static void sf_add_(std::atomic<std::int64_t>& counter, std::int64_t n) noexcept {
+                counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+            }
+
+            void mf_suspend_() noexcept {
+                const std::int64_t now = __coro::probe_now();
+                sf_add_(m_running_, now - m_stamp_.load(std::memory_order_relaxed));
+                m_stamp_.store(now, std::memory_order_relaxed);
+                m_is_suspended_.store(true, std::memory_order_relaxed);
+            }
+
+            void mf_resume_(bool counted) noexcept {
+                if (!m_is_suspended_.load(std::memory_order_relaxed))
+                    return;
+                const std::int64_t now = __coro::probe_now();
+                sf_add_(m_suspended_, now - m_stamp_.load(std::memory_order_relaxed));
+                m_stamp_.store(now, std::memory_order_relaxed);
+                m_is_suspended_.store(false, std::memory_order_relaxed);
+                if (counted)
+                    m_resumes_.store(m_resumes_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            }
+
+            void mf_register_() noexcept;   // defined in src/coroutine_instrumentation.cpp
+            void mf_unregister_() noexcept;
+
+          public:
+            frame_probe() noexcept = default;
+            frame_probe(const frame_probe&) = delete;
+            frame_probe& operator=(const frame_probe&) = delete;
+
+            ~frame_probe() {
+                if (m_attached_)
+                    this->mf_unregister_();
+            }
+
+            /// attach [ called by the promise constructor ]
+            void attach(std::source_location where) noexcept {
+                m_where_ = where;
+                // the last frame allocated on this thread, if it holds this
+                // promise; otherwise the allocation was elided
+                const auto* first = static_cast<const unsigned char*>(t_last_frame_.m_ptr_);
+                const auto* self  = reinterpret_cast<const unsigned char*>(this);
+                if (first != nullptr && first <= self && self < first + t_last_frame_.m_size_)
+                    m_frame_size_ = t_last_frame_.m_size_;
+                t_last_frame_ = {};
+                m_stamp_.store(__coro::probe_now(), std::memory_order_relaxed);
+                m_attached_ = true;
+                this->mf_register_();
+            }
+
+            /// wrap [ the awaiter of an initial or final suspend point ]
+            template <typename Awaiter>
+            probed_awaiter<Awaiter> wrap(Awaiter&& awaiter) noexcept(std::is_nothrow_move_constructible_v<Awaiter>) {
+                return probed_awaiter<Awaiter>(std::forward<Awaiter>(awaiter), *this);
+            }
+
+            /// transform [ the 'await_transform' of an instrumented promise ]
+            template <typename A>
+            auto transform(A&& awaitable) {
+                using awaiter_type = decltype(__coro::get_awaiter(std::forward<A>(awaitable)));
+                return probed_awaiter<awaiter_type>(__coro::get_awaiter(std::forward<A>(awaitable)), *this);
+            }
+        };
+
+        /// __coro::probed_awaiter
+        // forwards to 'Awaiter', a reference when the awaiter outlives the
+        // 'co_await' expression anyway, and tells the probe when the frame
+        // suspends and resumes. once the awaiter has been asked to suspend,
+        // the frame may be resumed, or gone, on another thread, so nothing
+        // is touched after that unless it declined
+        template <typename Awaiter>
+        class probed_awaiter {
+          private:
+            Awaiter      m_awaiter_;
+            frame_probe* m_probe_;
+
+          public:
+            probed_awaiter(Awaiter&& awaiter, frame_probe& probe)
+                noexcept(std::is_nothrow_constructible_v<Awaiter, Awaiter&&>)
+            : m_awaiter_(std::forward<Awaiter>(awaiter)), m_probe_(&probe) {}
+
+            [[nodiscard]] bool await_ready() noexcept(noexcept(m_awaiter_.await_ready())) {
+                return static_cast<bool>(m_awaiter_.await_ready());
+            }
+
+            template <typename Promise>
+            auto await_suspend(std::coroutine_handle<Promise> coro) noexcept(noexcept(m_awaiter_.await_suspend(coro))) {
+                m_probe_->mf_suspend_();
+                if constexpr (std::is_same_v<decltype(m_awaiter_.await_suspend(coro)), bool>) {
+                    const bool suspended = m_awaiter_.await_suspend(coro);
+                    if (!suspended)
+                        m_probe_->mf_resume_(false);
+                    return suspended;
+                } else {
+                    return m_awaiter_.await_suspend(coro);
+                }
+            }
+
+            decltype(auto) await_resume() noexcept(noexcept(m_awaiter_.await_resume())) {
+                m_probe_->mf_resume_(true);
+                return m_awaiter_.await_resume();
+            }
+        };
+
+#else
+
+        /// __coro::note_frame
+        inline void note_frame(const void*, std::size_t) noexcept {}
+
+        /// __coro::frame_probe [ nothing to record ]
+        class frame_probe {
+          public:
+            void attach(std::source_location) noexcept {}
+
+            template <typename Awaiter>
+            static Awaiter wrap(Awaiter awaiter) noexcept { return awaiter; }
+        };
+
+#endif // GOLD_COROUTINE_INSTRUMENTATION
+
+    } // namespace __coro
+
+} // namespace gold
+
+#endif // __GOLD_BITS_CORO_INSTRUMENTATION_HPP
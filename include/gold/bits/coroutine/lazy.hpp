@@ -11,6 +11,7 @@
 #include <utility>
 #include <bits/exception_ptr.h>
 #include <gold/bits/coroutine/awaitable.hpp>
+#include <gold/bits/coroutine/instrumentation.hpp>
 #include <gold/bits/coroutine/promise_allocator.hpp>
 #include <gold/bits/memory/ops.hpp>
 #include <gold/bits/type_traits/conditional.hpp>
@@ -69,6 +70,7 @@ namespace gold {
             };
             lazy_promise_state m_state_ = lazy_promise_state::empty_state;
             std::coroutine_handle<> m_cont_;
+            [[no_unique_address]] __coro::frame_probe m_probe_;
 
             struct awaiter {
                 std::coroutine_handle<lazy_promise_base> m_coro_;
@@ -136,9 +138,14 @@ namespace gold {
                 }
             }
 
-            std::suspend_always initial_suspend() noexcept { return {}; }
+            [[nodiscard]] auto initial_suspend() noexcept { return m_probe_.wrap(std::suspend_always{}); }
 
-            [[nodiscard]] auto final_suspend() noexcept { return lazy_final_awaiter<lazy_promise_base>{}; }
+            [[nodiscard]] auto final_suspend() noexcept { return m_probe_.wrap(lazy_final_awaiter<lazy_promise_base>{}); }
+
+#ifdef GOLD_COROUTINE_INSTRUMENTATION
+            template <typename A>
+            [[nodiscard]] auto await_transform(A&& awaitable) { return m_probe_.transform(std::forward<A>(awaitable)); }
+#endif
 
             void return_value(T val) noexcept requires std::is_reference_v<T> {
                 switch (m_state_) {
@@ -208,6 +215,7 @@ namespace gold {
             union { std::exception_ptr m_except_; };
             lazy_promise_state m_state_ = lazy_promise_state::empty_state;
             std::coroutine_handle<> m_cont_;
+            [[no_unique_address]] __coro::frame_probe m_probe_;
 
             struct awaiter {
                 std::coroutine_handle<lazy_promise_base> m_coro_;
@@ -244,9 +252,14 @@ namespace gold {
                     gold::destroy_at(std::addressof(m_except_));
             }
 
-            std::suspend_always initial_suspend() noexcept { return {}; }
+            [[nodiscard]] auto initial_suspend() noexcept { return m_probe_.wrap(std::suspend_always{}); }
+
+            [[nodiscard]] auto final_suspend() noexcept { return m_probe_.wrap(lazy_final_awaiter<lazy_promise_base>{}); }
 
-            [[nodiscard]] auto final_suspend() noexcept { return lazy_final_awaiter<lazy_promise_base>{}; }
+#ifdef GOLD_COROUTINE_INSTRUMENTATION
+            template <typename A>
+            [[nodiscard]] auto await_transform(A&& awaitable) { return m_probe_.transform(std::forward<A>(awaitable)); }
+#endif
 
             void return_void() noexcept {}
 
@@ -269,6 +282,13 @@ namespace gold {
     class [[nodiscard]] lazy {
       public:
         struct promise_type : __coro::promise_allocator<Alloc>, __coro::lazy_promise_base<T> {
+#ifdef GOLD_COROUTINE_INSTRUMENTATION
+            // the default argument names the coroutine function itself
+            promise_type(std::source_location where = std::source_location::current()) noexcept {
+                this->m_probe_.attach(where);
+            }
+#endif
+
             [[nodiscard]] lazy get_return_object() noexcept {
                 return lazy { std::coroutine_handle<promise_type>::from_promise(*this) };
             }
@@ -13,6 +13,8 @@
 #include <bits/uses_allocator.h>
 #include <gold/bits/algo/min_max.hpp>
 #include <gold/bits/concepts/allocator.hpp>
+#include <gold/bits/coroutine/frame_pool.hpp>
+#include <gold/bits/coroutine/instrumentation.hpp>
 
 namespace gold {
 
@@ -44,13 +46,16 @@ namespace gold {
             static void* s_allocate_(RebindedAlloc alloc, std::size_t n) {
                 if constexpr (s_is_stateless_alloc_) {
                     const std::size_t count_ = (n + sizeof(aligned_block) - 1) / sizeof(aligned_block);
-                    return alloc.allocate(count_);
+                    void* ptr_ = alloc.allocate(count_);
+                    __coro::note_frame(ptr_, n);
+                    return ptr_;
                 } else {
                     const std::size_t count_ = (n + sizeof(RebindedAlloc) + s_align_ - 1) / sizeof(aligned_block);
                     void* ptr_ = alloc.allocate(count_);
                     const auto alloc_address =
                         (reinterpret_cast<std::uintptr_t>(ptr_) + n + alignof(RebindedAlloc) - 1) & ~(alignof(RebindedAlloc) - 1);
                     ::new (reinterpret_cast<void*>(alloc_address)) RebindedAlloc(std::move(alloc));
+                    __coro::note_frame(ptr_, n);
                     return ptr_;
                 }
             }
@@ -114,6 +119,7 @@ namespace gold {
                     const std::size_t count_ = (n + sizeof(dealloc_fn) + sizeof(aligned_block) - 1) / sizeof(aligned_block);
                     void* ptr = rebinded_alloc.allocate(count_);
                     __builtin_memcpy(static_cast<char*>(ptr) + n, &dealloc, sizeof(dealloc));
+                    __coro::note_frame(ptr, n);
                     return ptr;
                 } else {
                     static constexpr std::size_t align_ = __algo::max_element({alignof(RebindedAlloc), sizeof(aligned_block)});
@@ -135,18 +141,25 @@ namespace gold {
                     const auto alloc_address =
                         (reinterpret_cast<std::uintptr_t>(ptr) + n + alignof(RebindedAlloc) - 1) & ~(alignof(RebindedAlloc) - 1);
                     ::new (reinterpret_cast<void*>(alloc_address)) RebindedAlloc { std::move(rebinded_alloc) };
+                    __coro::note_frame(ptr, n - sizeof(dealloc_fn));
                     return ptr;
                 }
             }
 
           public:
             static void* operator new(std::size_t n) {
+                // note: 'GOLD_COROUTINE_FRAME_POOL' must be the same for the whole program
+#ifdef GOLD_COROUTINE_FRAME_POOL
+                return s_allocate_(gold::frame_pool_allocator<aligned_block>(), n);
+#else
                 void* ptr = ::operator new[](n + sizeof(dealloc_fn));
                 const dealloc_fn dealloc = [](void* ptr, std::size_t n) {
                     ::operator delete[](ptr, n + sizeof(dealloc_fn));
                 };
                 __builtin_memcpy(static_cast<char*>(ptr) + n, &dealloc, sizeof(dealloc));
+                __coro::note_frame(ptr, n);
                 return ptr;
+#endif
             }
 
             template <typename Alloc, typename... Args>
@@ -0,0 +1,213 @@
+// <gold/bits/coroutine/sync_wait.hpp> - gold++ library
+
+// Copyright (C) [ 2021 - 2024 ] - present Desmond Gold
+
+// note: internal header
+
+#pragma once
+#ifndef __GOLD_BITS_CORO_SYNC_WAIT_HPP
+#define __GOLD_BITS_CORO_SYNC_WAIT_HPP
+
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <gold/bits/coroutine/awaitable.hpp>
+
+namespace gold {
+
+    namespace __coro {
+
+        /// __coro::sync_wait_event
+        // blocks the waiting thread without spinning; 'set' notifies while
+        // holding the lock so the waiter cannot return and destroy the event
+        // before the notifying thread is done with it
+        class sync_wait_event {
+          private:
+            std::mutex              m_mtx_;
+            std::condition_variable m_cv_;
+            bool                    m_set_ = false;
+
+          public:
+            void set() noexcept {
+                std::lock_guard guard (m_mtx_);
+                m_set_ = true;
+                m_cv_.notify_one();
+            }
+
+            void wait() noexcept {
+                std::unique_lock lock (m_mtx_);
+                m_cv_.wait(lock, [this] { return m_set_; });
+            }
+        };
+
+        /// __coro::sync_wait_task
+        template <typename R>
+        class sync_wait_task {
+          public:
+            class promise_type;
+
+          private:
+            std::coroutine_handle<promise_type> m_coro_;
+
+            explicit sync_wait_task(std::coroutine_handle<promise_type> coro) noexcept
+            : m_coro_(coro) {}
+
+          public:
+            class promise_type {
+              private:
+                friend sync_wait_task;
+
+                using stored_type = std::conditional_t<std::is_reference_v<R>, std::add_pointer_t<R>, R>;
+
+                sync_wait_event*           m_event_ = nullptr;
+                std::exception_ptr         m_except_;
+                std::optional<stored_type> m_value_;
+
+                struct final_awaiter {
+                    bool await_ready() noexcept { return false; }
+                    void await_suspend(std::coroutine_handle<promise_type> coro) noexcept {
+                        coro.promise().m_event_->set();
+                    }
+                    void await_resume() noexcept {}
+                };
+
+              public:
+                sync_wait_task get_return_object() noexcept {
+                    return sync_wait_task { std::coroutine_handle<promise_type>::from_promise(*this) };
+                }
+
+                std::suspend_always initial_suspend() noexcept { return {}; }
+
+                final_awaiter final_suspend() noexcept { return {}; }
+
+                template <typename U>
+                void return_value(U&& value) {
+                    if constexpr (std::is_reference_v<R>)
+                        m_value_.emplace(std::addressof(value));
+                    else
+                        m_value_.emplace(std::forward<U>(value));
+                }
+
+                void unhandled_exception() noexcept { m_except_ = std::current_exception(); }
+            };
+
+            sync_wait_task(sync_wait_task&& other) noexcept
+            : m_coro_(std::exchange(other.m_coro_, nullptr)) {}
+
+            ~sync_wait_task() {
+                if (m_coro_)
+                    m_coro_.destroy();
+            }
+
+            /// run [ returns once the awaited operation has completed ]
+            void run() {
+                sync_wait_event event;
+                m_coro_.promise().m_event_ = &event;
+                m_coro_.resume();
+                event.wait();
+            }
+
+            R result() {
+                auto& promise = m_coro_.promise();
+                if (promise.m_except_)
+                    std::rethrow_exception(promise.m_except_);
+                if constexpr (std::is_reference_v<R>)
+                    return static_cast<R>(**promise.m_value_);
+                else
+                    return std::move(*promise.m_value_);
+            }
+        };
+
+        /// __coro::sync_wait_task<Void>
+        template <>
+        class sync_wait_task<void> {
+          public:
+            class promise_type;
+
+          private:
+            std::coroutine_handle<promise_type> m_coro_;
+
+            explicit sync_wait_task(std::coroutine_handle<promise_type> coro) noexcept
+            : m_coro_(coro) {}
+
+          public:
+            class promise_type {
+              private:
+                friend sync_wait_task;
+
+                sync_wait_event*   m_event_ = nullptr;
+                std::exception_ptr m_except_;
+
+                struct final_awaiter {
+                    bool await_ready() noexcept { return false; }
+                    void await_suspend(std::coroutine_handle<promise_type> coro) noexcept {
+                        coro.promise().m_event_->set();
+                    }
+                    void await_resume() noexcept {}
+                };
+
+              public:
+                sync_wait_task get_return_object() noexcept {
+                    return sync_wait_task { std::coroutine_handle<promise_type>::from_promise(*this) };
+                }
+
+                std::suspend_always initial_suspend() noexcept { return {}; }
+
+                final_awaiter final_suspend() noexcept { return {}; }
+
+                void return_void() noexcept {}
+
+                void unhandled_exception() noexcept { m_except_ = std::current_exception(); }
+            };
+
+            sync_wait_task(sync_wait_task&& other) noexcept
+            : m_coro_(std::exchange(other.m_coro_, nullptr)) {}
+
+            ~sync_wait_task() {
+                if (m_coro_)
+                    m_coro_.destroy();
+            }
+
+            void run() {
+                sync_wait_event event;
+                m_coro_.promise().m_event_ = &event;
+                m_coro_.resume();
+                event.wait();
+            }
+
+            void result() {
+                if (m_coro_.promise().m_except_)
+                    std::rethrow_exception(m_coro_.promise().m_except_);
+            }
+        };
+
+        /// __coro::make_sync_wait_task
+        template <typename R, typename A>
+        sync_wait_task<R> make_sync_wait_task(A&& a) {
+            if constexpr (std::is_void_v<R>)
+                co_await std::forward<A>(a);
+            else
+                co_return co_await std::forward<A>(a);
+        }
+
+    } // namespace __coro
+
+    /// sync_wait
+    // blocks the calling thread until 'a' completes and returns its result;
+    // the thread sleeps while the operation runs elsewhere, e.g. on a
+    // 'thread_pool' after 'co_await pool.schedule()'
+    template <gold::awaitable A>
+    __coro::await_result_t<A> sync_wait(A&& a) {
+        auto task = __coro::make_sync_wait_task<__coro::await_result_t<A>>(std::forward<A>(a));
+        task.run();
+        return task.result();
+    }
+
+} // namespace gold
+
+#endif // __GOLD_BITS_CORO_SYNC_WAIT_HPP
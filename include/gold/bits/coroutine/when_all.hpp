@@ -0,0 +1,386 @@
+// <gold/bits/coroutine/when_all.hpp> - gold++ library
+
+// Copyright (C) [ 2021 - 2024 ] - present Desmond Gold
+
+// note: internal header
+
+#pragma once
+#ifndef __GOLD_BITS_CORO_WHEN_ALL_HPP
+#define __GOLD_BITS_CORO_WHEN_ALL_HPP
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <stop_token>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+#include <gold/bits/coroutine/awaitable.hpp>
+#include <gold/bits/type_traits/conditional.hpp>
+#include <gold/bits/void_like.hpp>
+
+namespace gold {
+
+    namespace __coro {
+
+        /// __coro::join_result_t [ what a child's result is stored and returned as ]
+        template <typename R>
+        using join_result_t = gold::conditional_t<std::is_void_v<R>, gold::void_like, R>;
+
+        /// __coro::when_all_counter
+        // the children and the awaiting coroutine each arrive once; it starts
+        // at one more than the number of children so that the awaiting
+        // coroutine is resumed only after it has started all of them
+        class when_all_counter {
+          private:
+            std::atomic<std::size_t> m_count_;
+            std::coroutine_handle<>  m_cont_;
+
+          public:
+            explicit when_all_counter(std::size_t count) noexcept
+            : m_count_(count + 1) {}
+
+            // only before any child has been started
+            when_all_counter(when_all_counter&& other) noexcept
+            : m_count_(other.m_count_.load(std::memory_order_relaxed)), m_cont_(other.m_cont_) {}
+
+            void set_continuation(std::coroutine_handle<> cont) noexcept { m_cont_ = cont; }
+
+            std::coroutine_handle<> continuation() const noexcept { return m_cont_; }
+
+            /// arrive [ true for the last one ]
+            bool arrive(std::size_t = 0) noexcept {
+                return m_count_.fetch_sub(1, std::memory_order_acq_rel) == 1;
+            }
+        };
+
+        /// __coro::when_any_counter
+        // also records the first child to complete and asks the others to stop
+        class when_any_counter : public when_all_counter {
+          private:
+            std::atomic<std::size_t> m_first_ { s_none_ };
+            std::stop_source         m_stop_;
+
+          public:
+            inline static constexpr std::size_t s_none_ = static_cast<std::size_t>(-1);
+
+            when_any_counter(std::size_t count, std::stop_source stop) noexcept
+            : when_all_counter(count), m_stop_(std::move(stop)) {}
+
+            when_any_counter(when_any_counter&& other) noexcept
+            : when_all_counter(std::move(other)), m_stop_(std::move(other.m_stop_)) {}
+
+            std::size_t first() const noexcept { return m_first_.load(std::memory_order_relaxed); }
+
+            bool arrive(std::size_t index) noexcept {
+                std::size_t none = s_none_;
+                if (m_first_.compare_exchange_strong(none, index, std::memory_order_relaxed))
+                    m_stop_.request_stop();
+                return when_all_counter::arrive();
+            }
+        };
+
+        /// __coro::join_promise_result
+        template <typename R>
+        class join_promise_result {
+          protected:
+            using stored_type = gold::conditional_t<std::is_reference_v<R>, std::add_pointer_t<R>, R>;
+
+            std::exception_ptr         m_except_;
+            std::optional<stored_type> m_value_;
+
+          public:
+            template <typename U>
+            void return_value(U&& value) {
+                if constexpr (std::is_reference_v<R>)
+                    m_value_.emplace(std::addressof(value));
+                else
+                    m_value_.emplace(std::forward<U>(value));
+            }
+
+            void unhandled_exception() noexcept { m_except_ = std::current_exception(); }
+
+            R take_result() {
+                if (m_except_)
+                    std::rethrow_exception(m_except_);
+                if constexpr (std::is_reference_v<R>)
+                    return static_cast<R>(**m_value_);
+                else
+                    return std::move(*m_value_);
+            }
+        };
+
+        template <>
+        class join_promise_result<void> {
+          protected:
+            std::exception_ptr m_except_;
+
+          public:
+            void return_void() noexcept {}
+
+            void unhandled_exception() noexcept { m_except_ = std::current_exception(); }
+
+            gold::void_like take_result() {
+                if (m_except_)
+                    std::rethrow_exception(m_except_);
+                return {};
+            }
+        };
+
+        /// __coro::join_task
+        // runs one child of 'when_all' or 'when_any' and arrives at the
+        // shared counter when done; the last one to arrive resumes the
+        // awaiting coroutine by symmetric transfer
+        template <typename R, typename Counter>
+        class join_task {
+          public:
+            class promise_type : public join_promise_result<R> {
+              private:
+                friend join_task;
+
+                Counter*    m_counter_ = nullptr;
+                std::size_t m_index_   = 0;
+
+                struct final_awaiter {
+                    bool await_ready() noexcept { return false; }
+
+                    std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> coro) noexcept {
+                        promise_type& promise = coro.promise();
+                        if (promise.m_counter_->arrive(promise.m_index_))
+                            return promise.m_counter_->continuation();
+                        return std::noop_coroutine();
+                    }
+
+                    void await_resume() noexcept {}
+                };
+
+              public:
+                join_task get_return_object() noexcept {
+                    return join_task { std::coroutine_handle<promise_type>::from_promise(*this) };
+                }
+
+                std::suspend_always initial_suspend() noexcept { return {}; }
+
+                final_awaiter final_suspend() noexcept { return {}; }
+            };
+
+          private:
+            std::coroutine_handle<promise_type> m_coro_;
+
+            explicit join_task(std::coroutine_handle<promise_type> coro) noexcept
+            : m_coro_(coro) {}
+
+          public:
+            join_task(join_task&& other) noexcept
+            : m_coro_(std::exchange(other.m_coro_, nullptr)) {}
+
+            join_task& operator=(join_task&& other) noexcept {
+                if (this != &other) {
+                    if (m_coro_)
+                        m_coro_.destroy();
+                    m_coro_ = std::exchange(other.m_coro_, nullptr);
+                }
+                return *this;
+            }
+
+            ~join_task() {
+                if (m_coro_)
+                    m_coro_.destroy();
+            }
+
+            /// start [ runs the child up to its first suspension ]
+            void start(Counter& counter, std::size_t index) noexcept {
+                m_coro_.promise().m_counter_ = &counter;
+                m_coro_.promise().m_index_   = index;
+                m_coro_.resume();
+            }
+
+            /// result [ pre: the child has completed ]
+            decltype(auto) result() { return m_coro_.promise().take_result(); }
+        };
+
+        /// __coro::make_join_task
+        // 'A' is an lvalue reference for lvalue awaitables, which are then
+        // awaited in place; rvalues are moved into the child's frame
+        template <typename Counter, typename A>
+        join_task<__coro::await_result_t<A>, Counter> make_join_task(A a) {
+            if constexpr (std::is_void_v<__coro::await_result_t<A>>)
+                co_await static_cast<A&&>(a);
+            else
+                co_return co_await static_cast<A&&>(a);
+        }
+
+        /// __coro::when_all_awaitable
+        template <typename... Rs>
+        class [[nodiscard]] when_all_awaitable {
+          private:
+            when_all_counter                                m_counter_;
+            std::tuple<join_task<Rs, when_all_counter>...>  m_tasks_;
+
+          public:
+            explicit when_all_awaitable(join_task<Rs, when_all_counter>&&... tasks) noexcept
+            : m_counter_(sizeof...(Rs)), m_tasks_(std::move(tasks)...) {}
+
+            when_all_awaitable(when_all_awaitable&&) noexcept = default;
+            when_all_awaitable& operator=(const when_all_awaitable&) = delete;
+
+            bool await_ready() const noexcept { return sizeof...(Rs) == 0; }
+
+            bool await_suspend(std::coroutine_handle<> cont) noexcept {
+                m_counter_.set_continuation(cont);
+                std::apply([this](auto&... tasks) {
+                    std::size_t index = 0;
+                    (tasks.start(m_counter_, index++), ...);
+                }, m_tasks_);
+                // everything may have completed inline
+                return !m_counter_.arrive();
+            }
+
+            /// await_resume [ braced, so the leftmost failure is the one rethrown ]
+            std::tuple<join_result_t<Rs>...> await_resume() {
+                return std::apply([](auto&... tasks) {
+                    return std::tuple<join_result_t<Rs>...>{ tasks.result()... };
+                }, m_tasks_);
+            }
+        };
+
+        /// __coro::when_all_range_awaitable
+        template <typename R>
+        class [[nodiscard]] when_all_range_awaitable {
+          private:
+            when_all_counter                            m_counter_;
+            std::vector<join_task<R, when_all_counter>> m_tasks_;
+
+            using value_type = gold::conditional_t<
+                std::is_reference_v<R>, std::reference_wrapper<std::remove_reference_t<R>>, R
+            >;
+
+          public:
+            explicit when_all_range_awaitable(std::vector<join_task<R, when_all_counter>>&& tasks) noexcept
+            : m_counter_(tasks.size()), m_tasks_(std::move(tasks)) {}
+
+            when_all_range_awaitable(when_all_range_awaitable&&) noexcept = default;
+            when_all_range_awaitable& operator=(const when_all_range_awaitable&) = delete;
+
+            bool await_ready() const noexcept { return m_tasks_.empty(); }
+
+            bool await_suspend(std::coroutine_handle<> cont) noexcept {
+                m_counter_.set_continuation(cont);
+                for (std::size_t i = 0; i < m_tasks_.size(); ++i)
+                    m_tasks_[i].start(m_counter_, i);
+                return !m_counter_.arrive();
+            }
+
+            auto await_resume() {
+                if constexpr (std::is_void_v<R>) {
+                    for (auto& task : m_tasks_)
+                        task.result();
+                } else {
+                    std::vector<value_type> results;
+                    results.reserve(m_tasks_.size());
+                    for (auto& task : m_tasks_)
+                        results.emplace_back(task.result());
+                    return results;
+                }
+            }
+        };
+
+        /// __coro::when_any_awaitable
+        template <typename... Rs>
+        class [[nodiscard]] when_any_awaitable {
+          private:
+            when_any_counter                                m_counter_;
+            std::tuple<join_task<Rs, when_any_counter>...>  m_tasks_;
+
+            template <std::size_t I, typename Result>
+            void mf_take_(Result& result) {
+                result.value.template emplace<I>(std::get<I>(m_tasks_).result());
+            }
+
+          public:
+            /// result
+            struct result_type {
+                std::size_t                           index;
+                std::variant<join_result_t<Rs>...>    value;
+            };
+
+            explicit when_any_awaitable(std::stop_source stop, join_task<Rs, when_any_counter>&&... tasks) noexcept
+            : m_counter_(sizeof...(Rs), std::move(stop)), m_tasks_(std::move(tasks)...) {}
+
+            when_any_awaitable(when_any_awaitable&&) noexcept = default;
+            when_any_awaitable& operator=(const when_any_awaitable&) = delete;
+
+            bool await_ready() const noexcept { return false; }
+
+            bool await_suspend(std::coroutine_handle<> cont) noexcept {
+                m_counter_.set_continuation(cont);
+                std::apply([this](auto&... tasks) {
+                    std::size_t index = 0;
+                    (tasks.start(m_counter_, index++), ...);
+                }, m_tasks_);
+                return !m_counter_.when_all_counter::arrive();
+            }
+
+            result_type await_resume() {
+                const std::size_t first = m_counter_.first();
+                return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                    result_type result { first, {} };
+                    ((first == Is ? this->mf_take_<Is>(result) : void()), ...);
+                    return result;
+                }(std::index_sequence_for<Rs...>{});
+            }
+        };
+
+    } // namespace __coro
+
+    /// when_all
+    // awaits every argument concurrently: each one is started in turn and
+    // runs until it first suspends, and the awaiting coroutine resumes on
+    // the thread that completes the last one. yields a tuple of the
+    // results, with 'void_like' for those that produce nothing; if any
+    // failed, the exception of the leftmost failing one is rethrown
+    template <gold::awaitable... As>
+    auto when_all(As&&... awaitables) {
+        return __coro::when_all_awaitable<__coro::await_result_t<As>...>(
+            __coro::make_join_task<__coro::when_all_counter, As>(std::forward<As>(awaitables))...
+        );
+    }
+
+    /// when_all [ range ]
+    // awaits every element of 'awaitables' concurrently and yields a vector
+    // of the results in the same order, or nothing if they return void
+    template <gold::awaitable A>
+    auto when_all(std::vector<A> awaitables) {
+        using result_type = __coro::await_result_t<A>;
+        std::vector<__coro::join_task<result_type, __coro::when_all_counter>> tasks;
+        tasks.reserve(awaitables.size());
+        for (auto& awaitable : awaitables)
+            tasks.push_back(__coro::make_join_task<__coro::when_all_counter, A>(std::move(awaitable)));
+        return __coro::when_all_range_awaitable<result_type>(std::move(tasks));
+    }
+
+    /// when_any
+    // awaits the arguments concurrently and yields the index and the result
+    // of the first one to complete. stop is requested on 'stop' as soon as
+    // one completes, so children that observe a token from it can finish
+    // early; the awaiting coroutine resumes once all of them have finished,
+    // since their frames are owned by the awaitable. there is no overload
+    // without 'stop': nothing else would end the losers early
+    template <gold::awaitable... As>
+        requires (sizeof...(As) > 0)
+    auto when_any(std::stop_source stop, As&&... awaitables) {
+        return __coro::when_any_awaitable<__coro::await_result_t<As>...>(
+            std::move(stop),
+            __coro::make_join_task<__coro::when_any_counter, As>(std::forward<As>(awaitables))...
+        );
+    }
+
+} // namespace gold
+
+#endif // __GOLD_BITS_CORO_WHEN_ALL_HPP
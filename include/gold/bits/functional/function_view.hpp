@@ -13,24 +13,15 @@
 #include <utility>
 #include <gold/invocable_traits>
 #include <gold/bits/memory/voidify.hpp>
-#include <gold/bits/memory/ops.hpp>
 #include <gold/bits/functional/invoke.hpp>
 #include <gold/bits/assume.hpp>
 #include <gold/bits/non_type.hpp>
 #include <gold/bits/type_traits/conditional.hpp>
-#include <gold/bits/unreachable.hpp>
 
 namespace gold {
 
     namespace __functional {
 
-        /// __functional::fn_view_kind
-        enum class fn_view_kind : unsigned char {
-            stateful,
-            stateless,
-            none
-        };
-
         /// __functional::qualified_function
         template <typename T>
         concept qualified_function = std::is_function_v<T>;
@@ -47,30 +38,22 @@ namespace gold {
         template <typename, bool, bool>
         class fn_view_base;
 
+        // every target is reduced to a thunk and the state it is handed: a call
+        // is one indirect call, and an empty view is a null thunk
         template <typename R, typename... Args, bool Const, bool Noexcept>
         class fn_view_base<R(Args...), Const, Noexcept> {
           private:
             using stateless_type = R(*)(Args...) noexcept(Noexcept);
-            using stateful_type  = R(*)(void*, Args...) noexcept(Noexcept);
 
-            void* m_state_;
-            union {
-                stateless_type m_stateless_fn_;
-                stateful_type  m_stateful_fn_;
+            union state_type {
+                void*          m_obj_;
+                stateless_type m_fn_;
             };
-            __functional::fn_view_kind m_kind_;
-
-            constexpr bool mf_is_stateful_() const noexcept {
-                return m_kind_ == __functional::fn_view_kind::stateful;
-            }
 
-            constexpr bool mf_is_stateless_() const noexcept {
-                return m_kind_ == __functional::fn_view_kind::stateless;
-            }
+            using thunk_type = R(*)(state_type, Args...) noexcept(Noexcept);
 
-            constexpr bool mf_is_none_() const noexcept {
-                return m_kind_ == __functional::fn_view_kind::none;
-            }
+            state_type m_state_;
+            thunk_type m_thunk_;
 
             template <typename... Ts>
             inline static constexpr bool s_is_invocable_using_ = []{
@@ -83,10 +66,49 @@ namespace gold {
             template <typename F>
             using maybe_const_t = gold::conditional_t<Const, const F, F>;
 
+            //// thunks
+            /// sf_call_fn_ [ a function pointer chosen at runtime ]
+            static constexpr R sf_call_fn_(state_type state, Args... args) noexcept(Noexcept) {
+                return state.m_fn_(std::forward<Args>(args)...);
+            }
+
+            /// sf_call_obj_ [ a callable object referred to by the view ]
+            template <typename T>
+            static constexpr R sf_call_obj_(state_type state, Args... args) noexcept(Noexcept) {
+                return gold::invoke_r<R>(
+                    static_cast<maybe_const_t<T>&>(*static_cast<T*>(state.m_obj_)),
+                    std::forward<Args>(args)...
+                );
+            }
+
+            /// sf_call_bound_ [ a callee fixed at compile time ]
+            template <auto F>
+            static constexpr R sf_call_bound_(state_type, Args... args) noexcept(Noexcept) {
+                return gold::invoke_r<R>(F, std::forward<Args>(args)...);
+            }
+
+            /// sf_call_bound_ref_ [ a callee fixed at compile time, given a bound object first ]
+            template <auto F, typename T>
+            static constexpr R sf_call_bound_ref_(state_type state, Args... args) noexcept(Noexcept) {
+                return gold::invoke_r<R>(F,
+                    static_cast<maybe_const_t<T>&>(*static_cast<T*>(state.m_obj_)),
+                    std::forward<Args>(args)...
+                );
+            }
+
+            /// sf_call_bound_ptr_ [ a callee fixed at compile time, given a bound pointer first ]
+            template <auto F, typename T>
+            static constexpr R sf_call_bound_ptr_(state_type state, Args... args) noexcept(Noexcept) {
+                return gold::invoke_r<R>(F,
+                    static_cast<maybe_const_t<T>*>(state.m_obj_),
+                    std::forward<Args>(args)...
+                );
+            }
+
           public:
             /// default ctor
             constexpr fn_view_base() noexcept
-            : m_state_(nullptr), m_kind_(__functional::fn_view_kind::none) {}
+            : m_state_{ .m_obj_ = nullptr }, m_thunk_(nullptr) {}
 
             /// copy ctor
             constexpr fn_view_base(const fn_view_base&) noexcept = default;
@@ -96,72 +118,48 @@ namespace gold {
                 requires __functional::qualified_function<std::remove_cvref_t<F>> &&
                          s_is_invocable_using_<maybe_const_t<std::remove_cvref_t<F>>&>
             constexpr fn_view_base(F&& f) noexcept
-            : m_state_(nullptr), m_stateless_fn_(gold::voidify(f)),
-              m_kind_(__functional::fn_view_kind::stateless) {}
+            : m_state_{ .m_fn_ = f }, m_thunk_(&sf_call_fn_) {}
 
-            /// ctor: taking already-function pointer
+            /// ctor: taking already-function pointer [ null gives an empty view ]
             template <typename F>
                 requires __functional::qualified_function<F>
                       && s_is_invocable_using_<F>
             constexpr fn_view_base(F* f) noexcept
-            : m_state_(nullptr), m_stateless_fn_(f),
-              m_kind_(__functional::fn_view_kind::stateless) {
-                if (f == nullptr)
-                    m_kind_ = __functional::fn_view_kind::none;
-              }
+            : m_state_{ .m_fn_ = f }, m_thunk_(f != nullptr ? &sf_call_fn_ : nullptr) {}
 
             /// ctor: taking any object convertible to function pointer
             template <typename F>
                 requires (!__functional::qualified_function<std::remove_cvref_t<F>>)
                         && std::is_convertible_v<F, R(*)(Args...) noexcept(Noexcept)>
             constexpr fn_view_base(F&& f) noexcept
-            : m_state_(nullptr), m_stateless_fn_(std::forward<F>(f)),
-              m_kind_(__functional::fn_view_kind::stateless) {}
-
-            /// ctor: NTTP member function pointer
-            template <auto M>
-                requires std::is_member_pointer_v<decltype(M)>
-                      && s_is_invocable_using_<decltype(M)>
-            constexpr fn_view_base(non_type_t<M>) noexcept
-            : m_state_(nullptr), m_stateless_fn_([](Args... args) noexcept(Noexcept) -> R {
-                return gold::invoke_r<R>(M, std::forward<Args>(args)...);
-            }), m_kind_(__functional::fn_view_kind::stateless) {}
-
-            /// ctor: NTTP member pointer with state
-            template <auto M, typename T>
-                requires std::is_member_pointer_v<decltype(M)>
-                      && s_is_invocable_using_<decltype(M), maybe_const_t<T>&>
-            constexpr fn_view_base(non_type_t<M>, T& state) noexcept
-            : m_state_(gold::voidify(state)),
-              m_stateful_fn_([](void* state, Args... args) noexcept(Noexcept) -> R {
-                return gold::invoke_r<R>(M,
-                    static_cast<maybe_const_t<T>&>(*static_cast<std::add_pointer_t<T>>(state)),
-                    std::forward<Args>(args)...
-                );
-            }), m_kind_(__functional::fn_view_kind::stateful) {}
-
-            /// ctor: NTTP member pointer with state pointer
-            template <auto M, typename T>
-                requires std::is_member_pointer_v<decltype(M)>
-                      && s_is_invocable_using_<decltype(M), maybe_const_t<T>*>
-            constexpr fn_view_base(non_type_t<M>, maybe_const_t<T>* state) noexcept
-            : m_state_(state),
-              m_stateful_fn_([](void* state, Args... args) noexcept(Noexcept) -> R {
-                return gold::invoke_r<R>(M,
-                    static_cast<std::add_pointer_t<maybe_const_t<T>>>(state),
-                    std::forward<Args>(args)...
-                );
-            }), m_kind_(__functional::fn_view_kind::stateful) {}
-
-            /// ctor: NTTP free function pointer
-            template <auto* M>
-                requires __functional::qualified_function<std::remove_pointer_t<decltype(M)>>
-            constexpr fn_view_base(non_type_t<M>) noexcept
-            : m_state_(nullptr), m_stateless_fn_(M), m_kind_(__functional::fn_view_kind::stateless) {}
+            : m_state_{ .m_fn_ = std::forward<F>(f) }, m_thunk_(&sf_call_fn_) {}
+
+            /// ctor: NTTP callable
+            // 'F' is a function pointer, a member pointer or a structural
+            // function object; the thunk calls it directly so it can be inlined
+            template <auto F>
+                requires s_is_invocable_using_<const decltype(F)&>
+            constexpr fn_view_base(non_type_t<F>) noexcept
+            : m_state_{ .m_obj_ = nullptr }, m_thunk_(&sf_call_bound_<F>) {}
+
+            /// ctor: NTTP callable with bound object
+            template <auto F, typename T>
+                requires (!std::is_function_v<T>)
+                      && s_is_invocable_using_<const decltype(F)&, maybe_const_t<T>&>
+            constexpr fn_view_base(non_type_t<F>, T& state) noexcept
+            : m_state_{ .m_obj_ = gold::voidify(state) }, m_thunk_(&sf_call_bound_ref_<F, T>) {}
+
+            /// ctor: NTTP callable with bound pointer
+            template <auto F, typename T>
+                requires (!std::is_function_v<T>)
+                      && s_is_invocable_using_<const decltype(F)&, maybe_const_t<T>*>
+            constexpr fn_view_base(non_type_t<F>, T* state) noexcept
+            : m_state_{ .m_obj_ = const_cast<void*>(static_cast<const volatile void*>(state)) },
+              m_thunk_(&sf_call_bound_ptr_<F, T>) {}
 
             /// ctor: nullptr
             constexpr fn_view_base(std::nullptr_t) noexcept
-            : m_state_(nullptr), m_kind_(__functional::fn_view_kind::none) {}
+            : m_state_{ .m_obj_ = nullptr }, m_thunk_(nullptr) {}
 
             /// ctor: non-function not convertible to function pointer
             template <typename F>
@@ -170,14 +168,8 @@ namespace gold {
                     && s_is_invocable_using_<maybe_const_t<std::remove_cvref_t<F>>&>
                     && (!std::is_convertible_v<F, R(*)(Args...) noexcept(Noexcept)>)
             constexpr fn_view_base(F&& f) noexcept
-            : m_state_(gold::voidify(f)),
-              m_stateful_fn_([](void* state, Args... args) noexcept(Noexcept) -> R {
-                using U = std::remove_reference_t<F>;
-                return gold::invoke_r<R>(
-                    static_cast<maybe_const_t<U>&>(*static_cast<std::add_pointer_t<U>>(state)),
-                    std::forward<Args>(args)...
-                );
-            }), m_kind_(__functional::fn_view_kind::stateful) {}
+            : m_state_{ .m_obj_ = gold::voidify(f) },
+              m_thunk_(&sf_call_obj_<std::remove_reference_t<F>>) {}
 
             /// copy assignment
             constexpr fn_view_base& operator=(const fn_view_base&) noexcept = default;
@@ -196,83 +188,31 @@ namespace gold {
 
             /// do_swap
             constexpr void do_swap(fn_view_base& other) noexcept {
-                if (this->mf_is_stateful_() && other.mf_is_stateful_()) {
-                    std::ranges::swap(m_state_, other.m_state_);
-                    std::ranges::swap(m_stateful_fn_, other.m_stateful_fn_);
-                } else if (this->mf_is_stateless_() && other.mf_is_stateless_()) {
-                    std::ranges::swap(m_stateless_fn_, other.m_stateless_fn_);
-                } else if (this->mf_is_none_() && other.mf_is_none_()) {
-                } else if (this->mf_is_stateful_() && other.mf_is_stateless_()) {
-                    auto this_temp_fn = m_stateful_fn_;
-                    gold::destroy_at(&m_stateful_fn_);
-                    auto other_temp_fn = other.m_stateless_fn_;
-                    gold::destroy_at(&other.m_stateless_fn_);
-                    gold::construct_at(&m_stateless_fn_, other_temp_fn);
-                    gold::construct_at(&other.m_stateful_fn_, this_temp_fn);
-                    other.m_state_ = std::exchange(m_state_, nullptr);
-                } else if (this->mf_is_stateless_() && other.mf_is_stateful_()) {
-                    auto this_temp_fn = m_stateless_fn_;
-                    gold::destroy_at(&m_stateless_fn_);
-                    auto other_temp_fn = other.m_stateful_fn_;
-                    gold::destroy_at(&other.m_stateful_fn_);
-                    gold::construct_at(&m_stateful_fn_, other_temp_fn);
-                    gold::construct_at(&other.m_stateless_fn_, this_temp_fn);
-                    m_state_ = std::exchange(other.m_state_, nullptr);
-                } else if (this->mf_is_stateful_() && other.mf_is_none_()) {
-                    auto this_temp_fn = m_stateful_fn_;
-                    gold::destroy_at(&m_stateful_fn_);
-                    gold::construct_at(&other.m_stateful_fn_, this_temp_fn);
-                    other.m_state_ = std::exchange(m_state_, nullptr);
-                } else if (this->mf_is_stateless_() && other.mf_is_none_()) {
-                    auto this_temp_fn = m_stateless_fn_;
-                    gold::destroy_at(&m_stateless_fn_);
-                    gold::construct_at(&other.m_stateless_fn_, this_temp_fn);
-                } else if (this->mf_is_none_() && other.mf_is_stateful_()) {
-                    auto other_temp_fn = other.m_stateful_fn_;
-                    gold::destroy_at(&other.m_stateful_fn_);
-                    gold::construct_at(&m_stateful_fn_, other_temp_fn);
-                    m_state_ = std::exchange(other.m_state_, nullptr);
-                } else if (this->mf_is_none_() && other.mf_is_stateless_()) {
-                    auto other_temp_fn = other.m_stateless_fn_;
-                    gold::destroy_at(&other.m_stateless_fn_);
-                    gold::construct_at(&m_stateless_fn_, other_temp_fn);
-                }
-                std::ranges::swap(m_kind_, other.m_kind_);
+                std::ranges::swap(m_state_, other.m_state_);
+                std::ranges::swap(m_thunk_, other.m_thunk_);
             }
 
             /// do_is_empty
             constexpr bool do_is_empty() const noexcept {
-                return mf_is_none_() ||
-                      (mf_is_stateless_() ? m_stateless_fn_ == nullptr :
-                      (m_state_ == nullptr || m_stateful_fn_ == nullptr));
+                return m_thunk_ == nullptr;
             }
 
-            /// do_eq
+            /// do_eq [ same thunk, and the same object or function ]
             constexpr bool do_eq(const fn_view_base& other) const noexcept {
-                if (m_kind_ != other.m_kind_)
+                if (m_thunk_ != other.m_thunk_)
                     return false;
-                if (this->mf_is_stateful_() && other.mf_is_stateful_())
-                    return m_state_ == other.m_state_ && m_stateful_fn_ == other.m_stateful_fn_;
-                else if (this->mf_is_stateless_() && other.mf_is_stateless_())
-                    return m_stateless_fn_ == other.m_stateless_fn_;
-                return true;
+                if (m_thunk_ == &sf_call_fn_)
+                    return m_state_.m_fn_ == other.m_state_.m_fn_;
+                return m_thunk_ == nullptr || m_state_.m_obj_ == other.m_state_.m_obj_;
             }
 
             /// operator()
             constexpr R operator()(Args... args) const noexcept(Noexcept) {
 
                 // precondition, should not be empty, otherwise undefined behaviour
-                gold::assume(!do_is_empty());
-
-                switch (m_kind_) {
-                    case __functional::fn_view_kind::stateless:
-                        return m_stateless_fn_(std::forward<Args>(args)...);
-                    case __functional::fn_view_kind::stateful:
-                        return m_stateful_fn_(m_state_, std::forward<Args>(args)...);
-                    default:;
-                }
+                gold::assume(m_thunk_ != nullptr);
 
-                gold::unreachable();
+                return m_thunk_(m_state_, std::forward<Args>(args)...);
 
             }
 
@@ -324,7 +264,7 @@ namespace gold {
             return base_type::do_is_empty();
         }
 
-        constexpr explicit operator bool() const noexcept { return base_type::do_is_empty(); }
+        constexpr explicit operator bool() const noexcept { return !base_type::do_is_empty(); }
 
     };
 
@@ -0,0 +1,436 @@
+// <gold/bits/functional/owning_function.hpp> - gold++ library
+
+// Copyright (C) [ 2021 - 2024 ] - present Desmond Gold
+
+// note: internal header
+
+#pragma once
+#ifndef __GOLD_BITS_FUNCTIONAL_OWNING_FUNCTION_HPP
+#define __GOLD_BITS_FUNCTIONAL_OWNING_FUNCTION_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <concepts>
+#include <utility>
+#include <gold/invocable_traits>
+#include <gold/bits/functional/invoke.hpp>
+#include <gold/bits/functional/function_view.hpp>
+#include <gold/bits/assume.hpp>
+#include <gold/bits/non_type.hpp>
+#include <gold/bits/type_traits/conditional.hpp>
+
+namespace gold {
+
+    namespace __functional {
+
+        /// __functional::fn_ops
+        // moves, copies, and destroys a stored target; owners keep a null
+        // pointer instead for targets whose bytes can simply be copied
+        struct fn_ops {
+            void (* relocate) (void* from, void* to) noexcept = nullptr;
+            void (* copy) (const void* from, void* to)        = nullptr; // null if not copyable
+            void (* destroy) (void*) noexcept                 = nullptr;
+        };
+
+        /// __functional::fn_storage
+        template <std::size_t Size>
+        union fn_storage {
+            static_assert(Size >= sizeof(void*), "the inline capacity must be able to hold a pointer");
+
+            void*                            m_ptr_; // heap-allocated target
+            alignas(void*) std::byte         m_buf_[Size];
+        };
+
+        /// __functional::fn_fits_inline
+        template <typename F, std::size_t Size>
+        concept fn_fits_inline = sizeof(F) <= Size
+            && alignof(void*) % alignof(F) == 0
+            && std::is_nothrow_move_constructible_v<F>;
+
+        /// __functional::fn_target
+        template <typename F, bool Inline>
+        struct fn_target {
+
+            /// s_get_
+            static F& s_get_(void* storage) noexcept {
+                if constexpr (Inline)
+                    return *std::launder(static_cast<F*>(storage));
+                else
+                    return **static_cast<F**>(storage);
+            }
+
+            /// s_create_
+            template <typename... Args>
+            static void s_create_(void* storage, Args&&... args) {
+                if constexpr (Inline)
+                    ::new (storage) F(std::forward<Args>(args)...);
+                else
+                    *static_cast<F**>(storage) = new F(std::forward<Args>(args)...);
+            }
+
+            /// s_relocate_
+            static void s_relocate_(void* from, void* to) noexcept {
+                if constexpr (Inline) {
+                    F& src = s_get_(from);
+                    ::new (to) F(std::move(src));
+                    src.~F();
+                } else {
+                    *static_cast<F**>(to) = *static_cast<F**>(from);
+                }
+            }
+
+            /// s_copy_
+            static void s_copy_(const void* from, void* to) {
+                s_create_(to, std::as_const(s_get_(const_cast<void*>(from))));
+            }
+
+            /// s_destroy_
+            static void s_destroy_(void* op) noexcept {
+                if constexpr (Inline)
+                    s_get_(op).~F();
+                else
+                    delete &s_get_(op);
+            }
+
+            /// s_invoke_
+            template <typename R, bool Const, bool Noexcept, typename... Args>
+            static R s_invoke_(void* storage, Args&&... args) noexcept(Noexcept) {
+                using target_type = gold::conditional_t<Const, const F, F>;
+                return gold::invoke_r<R>(static_cast<target_type&>(s_get_(storage)), std::forward<Args>(args)...);
+            }
+
+            /// s_is_trivial_ [ moved and copied as bytes, never destroyed ]
+            inline static constexpr bool s_is_trivial_ = Inline && std::is_trivially_copyable_v<F>;
+
+            /// s_make_ops_
+            template <bool Copyable>
+            static consteval fn_ops s_make_ops_() noexcept {
+                fn_ops result;
+                result.relocate = &s_relocate_;
+                if constexpr (Copyable)
+                    result.copy = &s_copy_;
+                result.destroy  = &s_destroy_;
+                return result;
+            }
+
+            /// s_ops_
+            template <bool Copyable>
+            inline static constexpr fn_ops s_ops_ = s_make_ops_<Copyable>();
+        };
+
+        /// __functional::fn_owner_base
+        // the target lives in 'm_storage_' when it fits, else on the heap if
+        // 'HeapFallback'; a call is one indirect call through 'm_invoke_'
+        template <typename, bool, bool, std::size_t, bool, bool>
+        class fn_owner_base;
+
+        template <typename R, typename... Args, bool Const, bool Noexcept,
+                  std::size_t Size, bool Copyable, bool HeapFallback>
+        class fn_owner_base<R(Args...), Const, Noexcept, Size, Copyable, HeapFallback> {
+          private:
+            using storage_type = __functional::fn_storage<Size>;
+            using invoke_type  = R(*)(void*, Args&&...) noexcept(Noexcept);
+
+            storage_type     m_storage_;
+            invoke_type      m_invoke_ = nullptr;
+            const fn_ops*    m_ops_    = nullptr; // null for trivial targets
+
+            template <typename F>
+            inline static constexpr bool s_is_invocable_using_ = []{
+                using target_type = gold::conditional_t<Const, const F, F>&;
+                if constexpr (Noexcept)
+                    return std::is_nothrow_invocable_r_v<R, target_type, Args...>;
+                else
+                    return std::is_invocable_r_v<R, target_type, Args...>;
+            }();
+
+            template <typename F>
+            inline static constexpr bool s_is_storable_ =
+                std::is_object_v<F> && s_is_invocable_using_<F>
+                && (Copyable ? std::copy_constructible<F> : std::move_constructible<F>);
+
+            template <typename F, typename... CArgs>
+            void mf_emplace_(CArgs&&... args) {
+                constexpr bool is_inline = __functional::fn_fits_inline<F, Size>;
+                static_assert(is_inline || HeapFallback,
+                    "the callable does not fit the inline capacity; "
+                    "it must be at most 'Capacity' bytes, pointer-aligned, and nothrow-movable");
+
+                using target = __functional::fn_target<F, is_inline>;
+                target::s_create_(&m_storage_, std::forward<CArgs>(args)...);
+                m_invoke_ = &target::template s_invoke_<R, Const, Noexcept, Args...>;
+                if constexpr (!target::s_is_trivial_)
+                    m_ops_ = &target::template s_ops_<Copyable>;
+            }
+
+            // pre: this is empty
+            void mf_take_(fn_owner_base& other) noexcept {
+                if (other.m_ops_ != nullptr)
+                    other.m_ops_->relocate(&other.m_storage_, &m_storage_);
+                else
+                    std::memcpy(&m_storage_, &other.m_storage_, sizeof(storage_type));
+                m_invoke_ = std::exchange(other.m_invoke_, nullptr);
+                m_ops_    = std::exchange(other.m_ops_, nullptr);
+            }
+
+          public:
+            /// default ctor
+            fn_owner_base() noexcept = default;
+
+            /// ctor: nullptr
+            fn_owner_base(std::nullptr_t) noexcept {}
+
+            /// copy ctor
+            fn_owner_base(const fn_owner_base& other) requires Copyable
+            : m_invoke_(other.m_invoke_), m_ops_(other.m_ops_) {
+                if (m_ops_ != nullptr)
+                    m_ops_->copy(&other.m_storage_, &m_storage_);
+                else
+                    std::memcpy(&m_storage_, &other.m_storage_, sizeof(storage_type));
+            }
+
+            /// move ctor
+            fn_owner_base(fn_owner_base&& other) noexcept {
+                this->mf_take_(other);
+            }
+
+            /// ctor: callable
+            // null function and member pointers leave it empty
+            template <typename F>
+                requires (!std::is_base_of_v<fn_owner_base, std::remove_cvref_t<F>>)
+                      && s_is_storable_<std::decay_t<F>>
+                      && std::constructible_from<std::decay_t<F>, F>
+            fn_owner_base(F&& f) {
+                using T = std::decay_t<F>;
+                if constexpr (std::is_pointer_v<T> || std::is_member_pointer_v<T>) {
+                    if (f == nullptr)
+                        return;
+                }
+                this->template mf_emplace_<T>(std::forward<F>(f));
+            }
+
+            /// ctor: in-place
+            template <typename T, typename... CArgs>
+                requires s_is_storable_<T> && std::constructible_from<T, CArgs...>
+            explicit fn_owner_base(std::in_place_type_t<T>, CArgs&&... args) {
+                this->template mf_emplace_<T>(std::forward<CArgs>(args)...);
+            }
+
+            /// ctor: NTTP callable [ nothing is stored ]
+            template <auto M>
+                requires s_is_invocable_using_<decltype(M)>
+            fn_owner_base(non_type_t<M>) noexcept
+            : m_invoke_([](void*, Args&&... args) noexcept(Noexcept) -> R {
+                return gold::invoke_r<R>(M, std::forward<Args>(args)...);
+            }) {}
+
+            /// dtor
+            ~fn_owner_base() { this->do_reset(); }
+
+            /// copy assignment
+            fn_owner_base& operator=(const fn_owner_base& other) requires Copyable {
+                if (this != &other)
+                    fn_owner_base(other).do_swap(*this);
+                return *this;
+            }
+
+            /// move assignment
+            fn_owner_base& operator=(fn_owner_base&& other) noexcept {
+                if (this != &other) {
+                    this->do_reset();
+                    this->mf_take_(other);
+                }
+                return *this;
+            }
+
+            /// do_reset
+            void do_reset() noexcept {
+                if (m_ops_ != nullptr)
+                    m_ops_->destroy(&m_storage_);
+                m_invoke_ = nullptr;
+                m_ops_    = nullptr;
+            }
+
+            /// do_swap
+            void do_swap(fn_owner_base& other) noexcept {
+                if (this == &other)
+                    return;
+                fn_owner_base temp (std::move(other));
+                other.mf_take_(*this);
+                this->mf_take_(temp);
+            }
+
+            /// do_is_empty
+            bool do_is_empty() const noexcept { return m_invoke_ == nullptr; }
+
+            /// operator()
+            R operator()(Args... args) noexcept(Noexcept) requires (!Const) {
+                // precondition, should not be empty, otherwise undefined behaviour
+                gold::assume(m_invoke_ != nullptr);
+                return m_invoke_(&m_storage_, std::forward<Args>(args)...);
+            }
+
+            R operator()(Args... args) const noexcept(Noexcept) requires Const {
+                // precondition, should not be empty, otherwise undefined behaviour
+                gold::assume(m_invoke_ != nullptr);
+                return m_invoke_(const_cast<storage_type*>(&m_storage_), std::forward<Args>(args)...);
+            }
+        };
+
+        /// __functional::owning_function_base_t
+        template <typename F, std::size_t Size, bool Copyable, bool HeapFallback>
+        using owning_function_base_t = fn_owner_base<
+            gold::remove_cvref_qualifier_noexcept_t<F>,
+            gold::has_const_qualifier_v<F>,
+            gold::is_noexcept_v<F>,
+            Size, Copyable, HeapFallback
+        >;
+
+    } // namespace __functional
+
+    /// inplace_function
+    // copyable; a callable that does not fit 'Capacity' is a compile-time error
+    template <typename F, std::size_t Capacity = 3 * sizeof(void*)>
+    class inplace_function;
+
+    template <typename F, std::size_t Capacity>
+        requires __functional::qualified_function<F>
+    class inplace_function<F, Capacity>
+    : private __functional::owning_function_base_t<F, Capacity, true, false> {
+      private:
+        using base_type = __functional::owning_function_base_t<F, Capacity, true, false>;
+
+      public:
+        using base_type::base_type;
+
+        inplace_function() noexcept = default;
+
+        template <typename G>
+            requires (!std::same_as<std::remove_cvref_t<G>, inplace_function>)
+                  && std::constructible_from<base_type, G>
+        inplace_function& operator=(G&& g) {
+            inplace_function(std::forward<G>(g)).swap(*this);
+            return *this;
+        }
+
+        inplace_function& operator=(std::nullptr_t) noexcept {
+            base_type::do_reset();
+            return *this;
+        }
+
+        void swap(inplace_function& other) noexcept {
+            base_type::do_swap(other);
+        }
+
+        friend void swap(inplace_function& lhs, inplace_function& rhs) noexcept {
+            lhs.swap(rhs);
+        }
+
+        using base_type::operator();
+
+        bool operator==(std::nullptr_t) const noexcept {
+            return base_type::do_is_empty();
+        }
+
+        explicit operator bool() const noexcept { return !base_type::do_is_empty(); }
+    };
+
+    /// move_only_function
+    // move-only; a callable that does not fit 'Capacity' is allocated
+    template <typename F, std::size_t Capacity = 3 * sizeof(void*)>
+    class move_only_function;
+
+    template <typename F, std::size_t Capacity>
+        requires __functional::qualified_function<F>
+    class move_only_function<F, Capacity>
+    : private __functional::owning_function_base_t<F, Capacity, false, true> {
+      private:
+        using base_type = __functional::owning_function_base_t<F, Capacity, false, true>;
+
+      public:
+        using base_type::base_type;
+
+        move_only_function() noexcept = default;
+
+        template <typename G>
+            requires (!std::same_as<std::remove_cvref_t<G>, move_only_function>)
+                  && std::constructible_from<base_type, G>
+        move_only_function& operator=(G&& g) {
+            move_only_function(std::forward<G>(g)).swap(*this);
+            return *this;
+        }
+
+        move_only_function& operator=(std::nullptr_t) noexcept {
+            base_type::do_reset();
+            return *this;
+        }
+
+        void swap(move_only_function& other) noexcept {
+            base_type::do_swap(other);
+        }
+
+        friend void swap(move_only_function& lhs, move_only_function& rhs) noexcept {
+            lhs.swap(rhs);
+        }
+
+        using base_type::operator();
+
+        bool operator==(std::nullptr_t) const noexcept {
+            return base_type::do_is_empty();
+        }
+
+        explicit operator bool() const noexcept { return !base_type::do_is_empty(); }
+    };
+
+    /// copyable_function
+    // copyable; a callable that does not fit 'Capacity' is allocated
+    template <typename F, std::size_t Capacity = 3 * sizeof(void*)>
+    class copyable_function;
+
+    template <typename F, std::size_t Capacity>
+        requires __functional::qualified_function<F>
+    class copyable_function<F, Capacity>
+    : private __functional::owning_function_base_t<F, Capacity, true, true> {
+      private:
+        using base_type = __functional::owning_function_base_t<F, Capacity, true, true>;
+
+      public:
+        using base_type::base_type;
+
+        copyable_function() noexcept = default;
+
+        template <typename G>
+            requires (!std::same_as<std::remove_cvref_t<G>, copyable_function>)
+                  && std::constructible_from<base_type, G>
+        copyable_function& operator=(G&& g) {
+            copyable_function(std::forward<G>(g)).swap(*this);
+            return *this;
+        }
+
+        copyable_function& operator=(std::nullptr_t) noexcept {
+            base_type::do_reset();
+            return *this;
+        }
+
+        void swap(copyable_function& other) noexcept {
+            base_type::do_swap(other);
+        }
+
+        friend void swap(copyable_function& lhs, copyable_function& rhs) noexcept {
+            lhs.swap(rhs);
+        }
+
+        using base_type::operator();
+
+        bool operator==(std::nullptr_t) const noexcept {
+            return base_type::do_is_empty();
+        }
+
+        explicit operator bool() const noexcept { return !base_type::do_is_empty(); }
+    };
+
+} // namespace gold
+
+#endif // __GOLD_BITS_FUNCTIONAL_OWNING_FUNCTION_HPP
@@ -0,0 +1,202 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <ranges>
+#include <gold/coroutine_instrumentation>
+#include <gold/format>
+
+/// every translation unit, this one included, must agree on 'GOLD_COROUTINE_INSTRUMENTATION'
+
+#ifdef GOLD_COROUTINE_INSTRUMENTATION
+
+namespace gold::__coro {
+
+    /// __coro::site_less [ source locations of the same function compare equal ]
+    struct site_less {
+        bool operator()(const std::source_location& a, const std::source_location& b) const noexcept {
+            if (a.line() != b.line())
+                return a.line() < b.line();
+            if (a.column() != b.column())
+                return a.column() < b.column();
+            if (const int c = std::strcmp(a.file_name(), b.file_name()); c != 0)
+                return c < 0;
+            return std::strcmp(a.function_name(), b.function_name()) < 0;
+        }
+    };
+
+    /// __coro::site_totals [ what destroyed frames left behind ]
+    struct site_totals {
+        std::size_t   m_created_   = 0;
+        std::uint64_t m_resumes_   = 0;
+        std::int64_t  m_running_   = 0;
+        std::int64_t  m_suspended_ = 0;
+    };
+
+    /// __coro::registry
+    struct registry {
+        std::mutex                                             m_mtx_;
+        frame_probe*                                           m_head_ = nullptr;
+        std::map<std::source_location, site_totals, site_less> m_sites_;
+    };
+
+    /// __coro::get_registry
+    registry& get_registry() noexcept {
+        // never destroyed, frames may outlive static destruction
+        static registry* s_registry = new registry;
+        return *s_registry;
+    }
+
+    /// frame_probe::mf_register_
+    void frame_probe::mf_register_() noexcept {
+        registry& reg = __coro::get_registry();
+        std::lock_guard guard (reg.m_mtx_);
+        m_next_ = reg.m_head_;
+        if (m_next_ != nullptr)
+            m_next_->m_prev_ = this;
+        reg.m_head_ = this;
+        try {
+            ++reg.m_sites_[m_where_].m_created_;
+        } catch (...) {
+            // the site goes uncounted
+        }
+    }
+
+    /// frame_probe::mf_unregister_
+    void frame_probe::mf_unregister_() noexcept {
+        // the final suspension lasts until the frame is destroyed
+        const std::int64_t now = __coro::probe_now();
+        if (m_is_suspended_.load(std::memory_order_relaxed))
+            sf_add_(m_suspended_, now - m_stamp_.load(std::memory_order_relaxed));
+        else
+            sf_add_(m_running_, now - m_stamp_.load(std::memory_order_relaxed));
+
+        registry& reg = __coro::get_registry();
+        std::lock_guard guard (reg.m_mtx_);
+        (m_prev_ != nullptr ? m_prev_->m_next_ : reg.m_head_) = m_next_;
+        if (m_next_ != nullptr)
+            m_next_->m_prev_ = m_prev_;
+        if (auto it = reg.m_sites_.find(m_where_); it != reg.m_sites_.end()) {
+            it->second.m_resumes_   += m_resumes_.load(std::memory_order_relaxed);
+            it->second.m_running_   += m_running_.load(std::memory_order_relaxed);
+            it->second.m_suspended_ += m_suspended_.load(std::memory_order_relaxed);
+        }
+    }
+
+} // namespace gold::__coro
+
+#endif // GOLD_COROUTINE_INSTRUMENTATION
+
+namespace gold {
+
+#ifdef GOLD_COROUTINE_INSTRUMENTATION
+
+    /// live_frames
+    std::vector<coroutine_frame_stats> coroutine_instrumentation::live_frames() {
+        std::vector<coroutine_frame_stats> result;
+        {
+            __coro::registry& reg = __coro::get_registry();
+            std::lock_guard guard (reg.m_mtx_);
+            const std::int64_t now = __coro::probe_now();
+            for (const __coro::frame_probe* p = reg.m_head_; p != nullptr; p = p->m_next_) {
+                const bool is_suspended = p->m_is_suspended_.load(std::memory_order_relaxed);
+                const std::int64_t since = now - p->m_stamp_.load(std::memory_order_relaxed);
+                std::int64_t running = p->m_running_.load(std::memory_order_relaxed);
+                std::int64_t suspended = p->m_suspended_.load(std::memory_order_relaxed);
+                (is_suspended ? suspended : running) += since;
+                result.push_back({
+                    .where        = p->m_where_,
+                    .frame_size   = p->m_frame_size_,
+                    .resumes      = p->m_resumes_.load(std::memory_order_relaxed),
+                    .running      = std::chrono::nanoseconds(running),
+                    .suspended    = std::chrono::nanoseconds(suspended),
+                    .is_suspended = is_suspended
+                });
+            }
+        }
+        std::ranges::stable_sort(result, std::ranges::greater{}, &coroutine_frame_stats::suspended);
+        return result;
+    }
+
+    /// sites
+    std::vector<coroutine_site_stats> coroutine_instrumentation::sites() {
+        std::map<std::source_location, coroutine_site_stats, __coro::site_less> merged;
+        {
+            __coro::registry& reg = __coro::get_registry();
+            std::lock_guard guard (reg.m_mtx_);
+            for (const auto& [where, totals] : reg.m_sites_) {
+                coroutine_site_stats& site = merged[where];
+                site.where     = where;
+                site.created   = totals.m_created_;
+                site.resumes   = totals.m_resumes_;
+                site.running   = std::chrono::nanoseconds(totals.m_running_);
+                site.suspended = std::chrono::nanoseconds(totals.m_suspended_);
+            }
+        }
+        // frames still alive have not been folded into the totals yet
+        for (const coroutine_frame_stats& frame : live_frames()) {
+            coroutine_site_stats& site = merged[frame.where];
+            site.where       = frame.where;
+            site.live       += 1;
+            site.live_bytes += frame.frame_size;
+            site.resumes    += frame.resumes;
+            site.running    += frame.running;
+            site.suspended  += frame.suspended;
+        }
+
+        std::vector<coroutine_site_stats> result;
+        result.reserve(merged.size());
+        for (auto& [where, site] : merged)
+            result.push_back(site);
+        std::ranges::stable_sort(result, std::ranges::greater{}, &coroutine_site_stats::running);
+        return result;
+    }
+
+    /// report
+    std::string coroutine_instrumentation::report(std::size_t n) {
+        const auto sf_ms = [](std::chrono::nanoseconds d) {
+            return std::chrono::duration<double, std::milli>(d).count();
+        };
+        const std::vector<coroutine_site_stats> site_stats = sites();
+        const std::vector<coroutine_frame_stats> frame_stats = live_frames();
+
+        std::string result;
+        auto out = std::back_inserter(result);
+        gold::format_to(out, "{:>8} {:>6} {:>10} {:>10} {:>12} {:>12}  {}\n",
+                        "created", "live", "bytes", "resumes", "running ms", "suspended ms", "coroutine");
+        for (const coroutine_site_stats& site : site_stats | std::views::take(n)) {
+            gold::format_to(out, "{:>8} {:>6} {:>10} {:>10} {:>12.3f} {:>12.3f}  {} [{}:{}]\n",
+                            site.created, site.live, site.live_bytes, site.resumes,
+                            sf_ms(site.running), sf_ms(site.suspended),
+                            site.where.function_name(), site.where.file_name(), site.where.line());
+        }
+        gold::format_to(out, "{} sites, {} live frames\n", site_stats.size(), frame_stats.size());
+
+        if (!frame_stats.empty()) {
+            gold::format_to(out, "\n{:>10} {:>10} {:>12} {:>12}  {}\n",
+                            "bytes", "resumes", "running ms", "suspended ms", "live frame");
+            for (const coroutine_frame_stats& frame : frame_stats | std::views::take(n)) {
+                gold::format_to(out, "{:>10} {:>10} {:>12.3f} {:>12.3f}  {}{} [{}:{}]\n",
+                                frame.frame_size, frame.resumes, sf_ms(frame.running), sf_ms(frame.suspended),
+                                frame.is_suspended ? "" : "(running) ",
+                                frame.where.function_name(), frame.where.file_name(), frame.where.line());
+            }
+        }
+        return result;
+    }
+
+#else
+
+    std::vector<coroutine_frame_stats> coroutine_instrumentation::live_frames() { return {}; }
+
+    std::vector<coroutine_site_stats> coroutine_instrumentation::sites() { return {}; }
+
+    std::string coroutine_instrumentation::report(std::size_t) {
+        return "coroutine instrumentation is disabled, define GOLD_COROUTINE_INSTRUMENTATION\n";
+    }
+
+#endif // GOLD_COROUTINE_INSTRUMENTATION
+
+} // namespace gold
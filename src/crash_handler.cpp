@@ -0,0 +1,511 @@
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <gold/crash_handler>
+#include <gold/stacktrace>
+
+#if defined(__linux__)
+
+#include <fcntl.h>
+#include <link.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+
+// everything reachable from 'on_crash' must stay async-signal-safe: no
+// allocation, no locks, no stdio, no calls into the loader. frames are
+// named from symbol tables read when the handler is installed
+
+namespace gold::__crash {
+
+    using __stacktrace::native_handle_type;
+
+    /// __crash::s_signals_
+    constexpr int s_signals_[] { SIGSEGV, SIGBUS, SIGFPE, SIGABRT };
+
+    /// __crash::s_signal_names_
+    constexpr const char* s_signal_names_[] { "SIGSEGV", "SIGBUS", "SIGFPE", "SIGABRT" };
+
+    constexpr std::size_t s_signal_count_ = std::size(s_signals_);
+    constexpr std::size_t s_max_modules_  = 256;
+    constexpr std::size_t s_max_frames_   = 128;
+    constexpr std::size_t s_path_size_    = 240;
+    constexpr std::size_t s_altstack_size_ = 64 * 1024;
+
+    /// __crash::symbol [ a function, at its loaded address ]
+    struct symbol {
+        std::uintptr_t  m_begin_;
+        std::uintptr_t  m_end_;
+        const char*     m_name_;   // in the mapping of its module's file
+    };
+
+    /// __crash::symbol_table
+    // the functions of one loaded module, sorted by address. tables are
+    // immutable once built and kept until the process exits, since a
+    // crash on another thread may be reading one while modules are
+    // snapshotted again
+    struct symbol_table {
+        std::uintptr_t      m_base_ = 0;
+        char                m_path_[s_path_size_] {};
+        void*               m_map_ = MAP_FAILED;
+        std::size_t         m_map_size_ = 0;
+        std::vector<symbol> m_symbols_;
+
+        symbol_table() = default;
+        symbol_table(const symbol_table&) = delete;
+        symbol_table& operator=(const symbol_table&) = delete;
+
+        ~symbol_table() {
+            if (m_map_ != MAP_FAILED)
+                ::munmap(m_map_, m_map_size_);
+        }
+
+        /// find [ null if 'pc' is in no known function ]
+        const symbol* find(std::uintptr_t pc) const noexcept {
+            auto it = std::upper_bound(m_symbols_.begin(), m_symbols_.end(), pc,
+                                       [](std::uintptr_t p, const symbol& sym) { return p < sym.m_begin_; });
+            if (it == m_symbols_.begin() || pc >= (--it)->m_end_)
+                return nullptr;
+            return &*it;
+        }
+    };
+
+    /// __crash::module_info [ an executable segment of a loaded module ]
+    struct module_info {
+        std::uintptr_t      m_begin_;
+        std::uintptr_t      m_end_;
+        std::uintptr_t      m_base_;
+        char                m_path_[s_path_size_];
+        const symbol_table* m_symbols_;
+    };
+
+    /// __crash::s_mutex_ [ serializes install and uninstall ]
+    constinit std::mutex s_mutex_;
+
+    /// __crash::s_modules_
+    constinit module_info s_modules_[s_max_modules_] {};
+    constinit std::atomic<std::size_t> s_module_count_ { 0 };
+
+    /// __crash::s_tables_ [ every symbol table built so far, under s_mutex_ ]
+    std::vector<std::unique_ptr<symbol_table>> s_tables_;
+
+    /// __crash::s_fd_
+    constinit std::atomic<int> s_fd_ { -1 };
+
+    /// __crash::s_installed_
+    constinit bool s_installed_ = false;
+
+    /// __crash::s_previous_ [ dispositions to restore, indexed like 's_signals_' ]
+    constinit struct ::sigaction s_previous_[s_signal_count_] {};
+
+    /// __crash::s_reporter_ [ tid of the thread writing a report, 0 if none ]
+    constinit std::atomic<long> s_reporter_ { 0 };
+
+    /// __crash::line_buffer
+    // formats one line on the stack and writes it out in one go
+    class line_buffer {
+      private:
+        char        m_data_[512];
+        std::size_t m_size_ = 0;
+
+      public:
+        line_buffer& append(const char* s) noexcept {
+            while (*s != '\0' && m_size_ < sizeof(m_data_))
+                m_data_[m_size_++] = *s++;
+            return *this;
+        }
+
+        line_buffer& append_hex(std::uintptr_t value) noexcept {
+            char digits[2 * sizeof(value)];
+            std::size_t n = 0;
+            do {
+                digits[n++] = "0123456789abcdef"[value & 0xf];
+                value >>= 4;
+            } while (value != 0);
+            this->append("0x");
+            while (n != 0 && m_size_ < sizeof(m_data_))
+                m_data_[m_size_++] = digits[--n];
+            return *this;
+        }
+
+        line_buffer& append_dec(long value) noexcept {
+            char digits[24];
+            std::size_t n = 0;
+            const bool negative = value < 0;
+            unsigned long u = negative ? 0ul - static_cast<unsigned long>(value) : static_cast<unsigned long>(value);
+            do {
+                digits[n++] = static_cast<char>('0' + u % 10);
+                u /= 10;
+            } while (u != 0);
+            if (negative)
+                this->append("-");
+            while (n != 0 && m_size_ < sizeof(m_data_))
+                m_data_[m_size_++] = digits[--n];
+            return *this;
+        }
+
+        void flush(int fd) noexcept {
+            const char* p = m_data_;
+            std::size_t left = m_size_;
+            while (left != 0) {
+                const ::ssize_t written = ::write(fd, p, left);
+                if (written < 0 && errno == EINTR)
+                    continue;
+                if (written <= 0)
+                    break;
+                p    += written;
+                left -= static_cast<std::size_t>(written);
+            }
+            m_size_ = 0;
+        }
+    };
+
+    /// __crash::copy_path
+    void copy_path(char (&dst)[s_path_size_], const char* src) noexcept {
+        std::size_t i = 0;
+        for (; src != nullptr && src[i] != '\0' && i + 1 < s_path_size_; ++i)
+            dst[i] = src[i];
+        dst[i] = '\0';
+    }
+
+    /// __crash::read_symbols
+    // maps the file of a module and collects the functions of its full
+    // symbol table, or of its dynamic one if it was stripped
+    void read_symbols(symbol_table& table, const char* file) {
+        const int fd = ::open(file, O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            return;
+        struct ::stat st {};
+        if (::fstat(fd, &st) == 0 && static_cast<std::size_t>(st.st_size) >= sizeof(ElfW(Ehdr))) {
+            table.m_map_size_ = static_cast<std::size_t>(st.st_size);
+            table.m_map_ = ::mmap(nullptr, table.m_map_size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        ::close(fd);
+        if (table.m_map_ == MAP_FAILED)
+            return;
+
+        const auto* image = static_cast<const unsigned char*>(table.m_map_);
+        const std::size_t size = table.m_map_size_;
+        const auto* ehdr = reinterpret_cast<const ElfW(Ehdr)*>(image);
+        if (std::memcmp(ehdr->e_ident, ELFMAG, SELFMAG) != 0 || ehdr->e_shentsize != sizeof(ElfW(Shdr))
+            || ehdr->e_shoff == 0 || ehdr->e_shoff + ehdr->e_shnum * sizeof(ElfW(Shdr)) > size)
+            return;
+        const auto* shdrs = reinterpret_cast<const ElfW(Shdr)*>(image + ehdr->e_shoff);
+
+        const ElfW(Shdr)* symtab = nullptr;
+        for (std::size_t i = 0; i < ehdr->e_shnum; ++i) {
+            if (shdrs[i].sh_type == SHT_SYMTAB)
+                symtab = &shdrs[i];
+            else if (shdrs[i].sh_type == SHT_DYNSYM && symtab == nullptr)
+                symtab = &shdrs[i];
+        }
+        if (symtab == nullptr || symtab->sh_link >= ehdr->e_shnum || symtab->sh_entsize != sizeof(ElfW(Sym))
+            || symtab->sh_offset + symtab->sh_size > size)
+            return;
+        const ElfW(Shdr)& strtab = shdrs[symtab->sh_link];
+        if (strtab.sh_offset + strtab.sh_size > size || strtab.sh_size == 0
+            || image[strtab.sh_offset + strtab.sh_size - 1] != '\0')
+            return;
+        const char* names = reinterpret_cast<const char*>(image + strtab.sh_offset);
+
+        const auto* syms = reinterpret_cast<const ElfW(Sym)*>(image + symtab->sh_offset);
+        const std::size_t count = symtab->sh_size / sizeof(ElfW(Sym));
+        for (std::size_t i = 0; i < count; ++i) {
+            const ElfW(Sym)& sym = syms[i];
+            if (ELF64_ST_TYPE(sym.st_info) != STT_FUNC || sym.st_shndx == SHN_UNDEF || sym.st_size == 0
+                || sym.st_name >= strtab.sh_size)
+                continue;
+            const std::uintptr_t begin = table.m_base_ + sym.st_value;
+            table.m_symbols_.push_back({ begin, begin + sym.st_size, names + sym.st_name });
+        }
+        std::ranges::sort(table.m_symbols_, {}, &symbol::m_begin_);
+    }
+
+    /// __crash::symbols_of [ pre: s_mutex_ is held; null if unavailable ]
+    const symbol_table* symbols_of(const ::dl_phdr_info& info, const char* path) noexcept {
+        for (const auto& table : s_tables_)
+            if (table->m_base_ == info.dlpi_addr && std::strcmp(table->m_path_, path) == 0)
+                return table.get();
+        try {
+            auto table = std::make_unique<symbol_table>();
+            table->m_base_ = info.dlpi_addr;
+            copy_path(table->m_path_, path);
+            // the main program is read through '/proc' in case it was started
+            // through 'PATH' or has been replaced on disk since
+            const bool is_program = info.dlpi_name == nullptr || info.dlpi_name[0] == '\0';
+            read_symbols(*table, is_program ? "/proc/self/exe" : info.dlpi_name);
+            s_tables_.push_back(std::move(table));
+            return s_tables_.back().get();
+        } catch (...) {
+            return nullptr;
+        }
+    }
+
+    /// __crash::snapshot_module
+    int snapshot_module(::dl_phdr_info* info, std::size_t, void* data) noexcept {
+        auto& count = *static_cast<std::size_t*>(data);
+        // the main program is reported with an empty name
+        const char* name = info->dlpi_name;
+        const char* path = name != nullptr && name[0] != '\0' ? name : program_invocation_name;
+        const symbol_table* symbols = nullptr;
+        for (std::size_t i = 0; i < info->dlpi_phnum && count < s_max_modules_; ++i) {
+            const auto& phdr = info->dlpi_phdr[i];
+            if (phdr.p_type != PT_LOAD || (phdr.p_flags & PF_X) == 0)
+                continue;
+            if (symbols == nullptr)
+                symbols = symbols_of(*info, path);
+            auto& mod   = s_modules_[count++];
+            mod.m_base_  = info->dlpi_addr;
+            mod.m_begin_ = info->dlpi_addr + phdr.p_vaddr;
+            mod.m_end_   = mod.m_begin_ + phdr.p_memsz;
+            mod.m_symbols_ = symbols;
+            copy_path(mod.m_path_, path);
+        }
+        return 0;
+    }
+
+    /// __crash::snapshot_modules [ pre: s_mutex_ is held ]
+    void snapshot_modules() noexcept {
+        s_module_count_.store(0, std::memory_order_release);
+        std::size_t count = 0;
+        ::dl_iterate_phdr(&snapshot_module, &count);
+        s_module_count_.store(count, std::memory_order_release);
+    }
+
+    /// __crash::find_module
+    const module_info* find_module(std::uintptr_t pc) noexcept {
+        const std::size_t count = s_module_count_.load(std::memory_order_acquire);
+        for (std::size_t i = 0; i < count; ++i)
+            if (s_modules_[i].m_begin_ <= pc && pc < s_modules_[i].m_end_)
+                return &s_modules_[i];
+        return nullptr;
+    }
+
+    /// __crash::frame_buffer
+    struct frame_buffer {
+        std::size_t         m_size_ = 0;
+        native_handle_type  m_pcs_[s_max_frames_];
+
+        static bool push(void* data, native_handle_type pc) noexcept {
+            auto& self = *static_cast<frame_buffer*>(data);
+            self.m_pcs_[self.m_size_++] = pc;
+            return self.m_size_ < s_max_frames_;
+        }
+    };
+
+    /// __crash::signal_index
+    std::size_t signal_index(int sig) noexcept {
+        for (std::size_t i = 0; i < s_signal_count_; ++i)
+            if (s_signals_[i] == sig)
+                return i;
+        return s_signal_count_;
+    }
+
+    /// __crash::write_header
+    void write_header(int fd, int sig, const ::siginfo_t* info, long tid) noexcept {
+        const std::size_t index = signal_index(sig);
+        line_buffer line;
+        line.append("*** gold: caught ")
+            .append(index < s_signal_count_ ? s_signal_names_[index] : "signal")
+            .append(" (").append_dec(sig).append(")");
+        if (info != nullptr && (sig == SIGSEGV || sig == SIGBUS || sig == SIGFPE))
+            line.append(" at address ").append_hex(reinterpret_cast<std::uintptr_t>(info->si_addr));
+        line.append(" in thread ").append_dec(tid).append(" ***\n");
+        line.flush(fd);
+    }
+
+    /// __crash::write_modules_pass [ raw program counters and module offsets ]
+    void write_modules_pass(int fd, const frame_buffer& frames) noexcept {
+        for (std::size_t i = 0; i < frames.m_size_; ++i) {
+            const std::uintptr_t pc = frames.m_pcs_[i];
+            line_buffer line;
+            line.append("   #").append_dec(static_cast<long>(i)).append(" ").append_hex(pc).append(" in ");
+            if (const module_info* mod = find_module(pc))
+                line.append(mod->m_path_).append("+").append_hex(pc - mod->m_base_);
+            else
+                line.append("??");
+            line.append("\n").flush(fd);
+        }
+    }
+
+    /// __crash::write_symbols_pass
+    // looks each frame up in the symbol tables read at installation; names
+    // are left mangled since demangling allocates
+    void write_symbols_pass(int fd, const frame_buffer& frames) noexcept {
+        line_buffer line;
+        line.append("*** symbols ***\n").flush(fd);
+        for (std::size_t i = 0; i < frames.m_size_; ++i) {
+            const std::uintptr_t pc = frames.m_pcs_[i];
+            const module_info* mod = find_module(pc);
+            const symbol* sym = mod != nullptr && mod->m_symbols_ != nullptr ? mod->m_symbols_->find(pc) : nullptr;
+            line.append("   #").append_dec(static_cast<long>(i)).append(" ");
+            if (sym != nullptr)
+                line.append(sym->m_name_).append("+").append_hex(pc - sym->m_begin_);
+            else
+                line.append("??");
+            line.append("\n").flush(fd);
+        }
+    }
+
+    /// __crash::on_crash
+    void on_crash(int sig, ::siginfo_t* info, void*) noexcept {
+        const int saved_errno = errno;
+        const long tid = ::syscall(SYS_gettid);
+
+        long expected = 0;
+        if (!s_reporter_.compare_exchange_strong(expected, tid, std::memory_order_acq_rel)) {
+            if (expected != tid) {
+                // another thread is reporting and will take the process down
+                for (;;)
+                    ::pause();
+            }
+            // crashed while reporting; let the default action finish the job
+            ::signal(sig, SIG_DFL);
+            errno = saved_errno;
+            return;
+        }
+
+        const int fd = s_fd_.load(std::memory_order_relaxed);
+        if (fd >= 0) {
+            frame_buffer frames;
+            // skips this handler and the signal trampoline
+            __stacktrace::unwind(2, &frame_buffer::push, &frames);
+            write_header(fd, sig, info, tid);
+            write_modules_pass(fd, frames);
+            write_symbols_pass(fd, frames);
+        }
+
+        // hand over to whatever was installed before; a synchronous fault
+        // is raised again when the faulting instruction is resumed, others
+        // are delivered as soon as this handler returns
+        const std::size_t index = signal_index(sig);
+        if (index < s_signal_count_)
+            ::sigaction(sig, &s_previous_[index], nullptr);
+        else
+            ::signal(sig, SIG_DFL);
+        if (info == nullptr || info->si_code <= 0)
+            ::raise(sig);
+        errno = saved_errno;
+    }
+
+    /// __crash::altstack_guard
+    struct altstack_guard {
+        void* m_stack_ = nullptr;
+
+        ~altstack_guard() {
+            if (m_stack_ == nullptr)
+                return;
+            ::stack_t disable {};
+            disable.ss_flags = SS_DISABLE;
+            ::sigaltstack(&disable, nullptr);
+            ::munmap(m_stack_, s_altstack_size_);
+        }
+    };
+
+    /// __crash::t_altstack_
+    thread_local altstack_guard t_altstack_;
+
+    /// __crash::warm_up
+    // resolves lazily bound functions and lets the unwinder build its
+    // caches while it is still safe to allocate
+    void warm_up() noexcept {
+        frame_buffer frames;
+        __stacktrace::unwind(0, &frame_buffer::push, &frames);
+        ::syscall(SYS_gettid);
+    }
+
+} // namespace gold::__crash
+
+namespace gold {
+
+    /// prepare_crash_handler_thread
+    void prepare_crash_handler_thread() {
+        auto& guard = __crash::t_altstack_;
+        if (guard.m_stack_ != nullptr)
+            return;
+
+        // leave an alternate stack installed by someone else alone
+        ::stack_t current {};
+        if (::sigaltstack(nullptr, &current) == 0 && (current.ss_flags & SS_DISABLE) == 0)
+            return;
+
+        void* stack = ::mmap(nullptr, __crash::s_altstack_size_, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (stack == MAP_FAILED)
+            throw crash_handler_error("failed to allocate the alternate signal stack");
+
+        ::stack_t alt {};
+        alt.ss_sp    = stack;
+        alt.ss_size  = __crash::s_altstack_size_;
+        alt.ss_flags = 0;
+        if (::sigaltstack(&alt, nullptr) != 0) {
+            ::munmap(stack, __crash::s_altstack_size_);
+            throw crash_handler_error("failed to install the alternate signal stack");
+        }
+        guard.m_stack_ = stack;
+    }
+
+    /// install_crash_handler
+    void install_crash_handler(int fd) {
+        std::lock_guard guard (__crash::s_mutex_);
+
+        gold::prepare_crash_handler_thread();
+        __crash::snapshot_modules();
+        __crash::warm_up();
+        __crash::s_fd_.store(fd, std::memory_order_relaxed);
+
+        if (__crash::s_installed_)
+            return;
+
+        struct ::sigaction action {};
+        action.sa_sigaction = &__crash::on_crash;
+        action.sa_flags     = SA_SIGINFO | SA_ONSTACK;
+        ::sigemptyset(&action.sa_mask);
+
+        for (std::size_t i = 0; i < __crash::s_signal_count_; ++i) {
+            if (::sigaction(__crash::s_signals_[i], &action, &__crash::s_previous_[i]) != 0) {
+                while (i-- != 0)
+                    ::sigaction(__crash::s_signals_[i], &__crash::s_previous_[i], nullptr);
+                throw crash_handler_error("failed to install the crash handler");
+            }
+        }
+        __crash::s_installed_ = true;
+    }
+
+    /// uninstall_crash_handler
+    void uninstall_crash_handler() noexcept {
+        std::lock_guard guard (__crash::s_mutex_);
+        if (!__crash::s_installed_)
+            return;
+        for (std::size_t i = 0; i < __crash::s_signal_count_; ++i)
+            ::sigaction(__crash::s_signals_[i], &__crash::s_previous_[i], nullptr);
+        __crash::s_installed_ = false;
+        __crash::s_fd_.store(-1, std::memory_order_relaxed);
+    }
+
+} // namespace gold
+
+#else
+
+namespace gold {
+
+    // the handler relies on 'sigaction', 'sigaltstack' and elf symbol tables
+
+    void prepare_crash_handler_thread() {}
+
+    void install_crash_handler(int) {
+        throw crash_handler_error("install_crash_handler: not supported on this platform");
+    }
+
+    void uninstall_crash_handler() noexcept {}
+
+} // namespace gold
+
+#endif // __linux__
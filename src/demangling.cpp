@@ -1,26 +1,138 @@
 #include <gold/demangling>
 #include <cstdlib>
-#include <memory>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
 #include <cxxabi.h>
 
+namespace gold::__demangling {
+
+    /// __demangling::thread_demangler
+    demangler& thread_demangler() noexcept {
+        thread_local demangler result;
+        return result;
+    }
+
+    /// __demangling::name_hash
+    struct name_hash {
+        using is_transparent = void;
+
+        std::size_t operator()(std::string_view s) const noexcept {
+            return std::hash<std::string_view>{}(s);
+        }
+    };
+
+    /// __demangling::cache_shard
+    struct alignas(64) cache_shard {
+        std::mutex                                      m_mtx_;
+        std::unordered_map<std::string, std::shared_ptr<const std::string>,
+                           name_hash, std::equal_to<>>  m_names_;
+        std::deque<std::string_view>                    m_order_; // keys by age, oldest first
+    };
+
+    /// __demangling::cache_state
+    struct cache_state {
+        static constexpr std::size_t s_shard_count_ = 16;
+
+        cache_shard  m_shards_[s_shard_count_];
+        std::size_t  m_capacity_;
+        std::size_t  m_shard_capacity_;
+
+        explicit cache_state(std::size_t capacity)
+        : m_capacity_(capacity),
+          m_shard_capacity_(std::max<std::size_t>(1, capacity / s_shard_count_)) {}
+
+        cache_shard& shard_of(std::string_view mangled) noexcept {
+            return m_shards_[name_hash{}(mangled) % s_shard_count_];
+        }
+    };
+
+} // namespace gold::__demangling
+
 namespace gold {
 
     /// demangle
     std::string demangle(std::string_view name) noexcept {
+        return std::string(__demangling::thread_demangler()(name));
+    }
 
-        using smart_ptr_type = std::unique_ptr<char, void(*)(void*)>;
+    /// demangler dtor
+    demangler::~demangler() {
+        std::free(m_buffer_);
+    }
+
+    /// demangler::operator()
+    std::string_view demangler::operator()(std::string_view mangled) noexcept {
+        try {
+            m_input_.assign(mangled);
+        } catch (...) {
+            return mangled;
+        }
+
+        // '__cxa_demangle' reallocates the buffer and updates the capacity
+        // only when the result does not fit; on failure it leaves both alone
+        int status = 0;
+        char* result = __cxxabiv1::__cxa_demangle(m_input_.c_str(), m_buffer_, &m_capacity_, &status);
+        if (status != 0 || result == nullptr)
+            return m_input_;
+        m_buffer_ = result;
+        return std::string_view(m_buffer_, std::strlen(m_buffer_));
+    }
+
+    /// demangle_cache ctors
+    demangle_cache::demangle_cache(size_type capacity)
+    : m_state_(std::make_unique<__demangling::cache_state>(capacity)) {}
+
+    /// demangle_cache dtor
+    demangle_cache::~demangle_cache() = default;
 
-        int status_value;
-        smart_ptr_type ptr (
-            __cxxabiv1::__cxa_demangle(name.data(), nullptr, nullptr, &status_value),
-            &std::free
-        );
+    /// mf_lookup_
+    std::shared_ptr<const std::string> demangle_cache::mf_lookup_(std::string_view mangled) {
+        auto& shard = m_state_->shard_of(mangled);
+        {
+            std::lock_guard guard (shard.m_mtx_);
+            if (auto it = shard.m_names_.find(mangled); it != shard.m_names_.end())
+                return it->second;
+        }
 
-        if (status_value != 0)
-            return std::string(name);
-        else
-            return ptr.get();
+        // demangle outside of the lock; a racing thread may insert first
+        auto result = std::make_shared<const std::string>(__demangling::thread_demangler()(mangled));
+
+        std::lock_guard guard (shard.m_mtx_);
+        auto [it, inserted] = shard.m_names_.try_emplace(std::string(mangled), result);
+        if (!inserted)
+            return it->second;
+        shard.m_order_.push_back(it->first);
+        while (shard.m_names_.size() > m_state_->m_shard_capacity_) {
+            shard.m_names_.erase(shard.m_names_.find(shard.m_order_.front()));
+            shard.m_order_.pop_front();
+        }
+        return result;
+    }
+
+    /// clear
+    void demangle_cache::clear() noexcept {
+        for (auto& shard : m_state_->m_shards_) {
+            std::lock_guard guard (shard.m_mtx_);
+            shard.m_order_.clear();
+            shard.m_names_.clear();
+        }
     }
 
+    /// size
+    auto demangle_cache::size() const noexcept -> size_type {
+        size_type result = 0;
+        for (auto& shard : m_state_->m_shards_) {
+            std::lock_guard guard (shard.m_mtx_);
+            result += shard.m_names_.size();
+        }
+        return result;
+    }
+
+    /// capacity
+    auto demangle_cache::capacity() const noexcept -> size_type {
+        return m_state_->m_capacity_;
+    }
 
 } // namespace gold
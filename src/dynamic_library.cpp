@@ -1,9 +1,15 @@
 #include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <ranges>
 #include <gold/dynamic_library>
 #include <gold/utility>
+
+#if defined(_WIN32)
 #include <windows.h>
 #include <psapi.h>
 #include <dbghelp.h>
@@ -11,6 +17,18 @@
 
 /// requires additional linker flags:
 /// -ldbghelp -limagehlp
+#else
+#include <cstring>
+#include <dlfcn.h>
+#include <elf.h>
+#include <fcntl.h>
+#include <link.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/// requires additional linking '-ldl'
+#endif
 
 namespace __goldx {
 
@@ -23,46 +41,89 @@ namespace __goldx {
     /// __goldx::dl_module_byte_array_ref
     using dl_module_byte_array_ref = std::byte (&) [dl_module_storage_max_size];
 
-    /// __goldx::dl_module_storage_impl
-    struct dl_module_storage_impl {
-        std::vector<std::string>     m_sym_names_;
-        std::vector<gold::dl_symbol> m_syms_;
-        std::string                  m_mod_name_;
-        std::string                  m_img_name_;
-        bool                         m_auto_free_ = false;
-        ::HINSTANCE__*               m_handle_    = nullptr;
+    /// __goldx::library_info
+    struct library_info {
+        const void* base  = nullptr;
+        const void* entry = nullptr;
+        std::size_t size  = 0;
+    };
 
-        void swap(dl_module_storage_impl& other) noexcept {
-            using std::swap;
-            swap(m_sym_names_, other.m_sym_names_);
-            swap(m_syms_, other.m_syms_);
-            swap(m_mod_name_, other.m_mod_name_);
-            swap(m_img_name_, other.m_img_name_);
-            swap(m_auto_free_, other.m_auto_free_);
-            swap(m_handle_, other.m_handle_);
-        }
+    /// __goldx::safe_gotten_library_result
+    template <typename Handle>
+    struct safe_gotten_library_result {
+        Handle    mod;
+        bool      auto_free;
+    };
 
-        static dl_module_storage_impl* s_get_(dl_module_byte_array_ref data) {
-            return std::launder(reinterpret_cast<dl_module_storage_impl*>(data));
+    /// __goldx::hashed_index
+    // an open-addressing table over 'gold::dl_symbol_hash'es for export
+    // tables that do not come with a hash table of their own
+    struct hashed_index {
+        static constexpr std::size_t npos = std::size_t(-1);
+
+        struct slot {
+            std::uint32_t hash;
+            std::uint32_t position; // plus one, zero marks an empty slot
+        };
+
+        std::vector<slot> m_slots_;
+
+        template <typename NameAt>
+        void build(const std::vector<std::uint32_t>& positions, NameAt name_at) {
+            m_slots_.assign(std::bit_ceil(positions.size() * 2 + 1), slot{});
+            const std::size_t mask = m_slots_.size() - 1;
+            for (std::uint32_t position : positions) {
+                const std::uint32_t hash = gold::dl_symbol_hash(name_at(position));
+                std::size_t i = hash & mask;
+                while (m_slots_[i].position != 0)
+                    i = (i + 1) & mask;
+                m_slots_[i] = { hash, position + 1 };
+            }
         }
 
-        static dl_module_storage_impl* s_init_(dl_module_byte_array_ref data) {
-             return std::construct_at(s_get_(data));
+        template <typename NameAt>
+        std::size_t find(std::string_view name, std::uint32_t hash, NameAt name_at) const noexcept {
+            if (m_slots_.empty())
+                return npos;
+            const std::size_t mask = m_slots_.size() - 1;
+            for (std::size_t i = hash & mask; m_slots_[i].position != 0; i = (i + 1) & mask)
+                if (m_slots_[i].hash == hash && name_at(m_slots_[i].position - 1) == name)
+                    return m_slots_[i].position - 1;
+            return npos;
         }
+    };
 
-        static void s_destroy_(dl_module_byte_array_ref data) {
-            std::destroy_at(s_get_(data));
+#if defined(_WIN32)
+
+    /// __goldx::native_library
+    using native_library = ::HMODULE;
+
+    /// __goldx::export_table
+    struct export_table {
+        ::HMODULE                     m_handle_ = nullptr;
+        std::vector<std::string>      m_storage_;
+        std::vector<std::string_view> m_names_;
+        hashed_index                  m_index_;
+
+        gold::dl_symbol::native_handle_type find(std::string_view name, std::uint32_t hash) const noexcept {
+            const std::size_t i = m_index_.find(name, hash, [this](std::size_t i) { return m_names_[i]; });
+            if (i == hashed_index::npos)
+                return nullptr;
+            // export names are null-terminated within the storage
+            return reinterpret_cast<gold::dl_symbol::native_handle_type>(::GetProcAddress(m_handle_, m_storage_[i].c_str()));
         }
+
+        std::span<const std::string_view> names() const noexcept { return m_names_; }
     };
 
     /// __goldx::load_library
     static ::HMODULE load_library [[maybe_unused]] (std::string_view sv) {
-        return ::LoadLibrary(sv.data());
+        return ::LoadLibrary(std::string(sv).c_str());
     }
 
     /// __goldx::get_library
     static ::HMODULE get_library [[maybe_unused]] (std::string_view sv) {
-        return ::GetModuleHandle(sv.data());
+        return ::GetModuleHandle(std::string(sv).c_str());
     }
 
     /// __goldx::is_library_loaded
@@ -70,14 +131,8 @@ namespace __goldx {
         return get_library(sv) != nullptr;
     }
 
-    /// __goldx::safe_gotten_library_result
-    struct safe_gotten_library_result {
-        ::HMODULE mod;
-        bool      auto_free;
-    };
-
     /// __goldx::safe_get_library
-    static safe_gotten_library_result safe_get_library [[maybe_unused]] (std::string_view sv) {
+    static safe_gotten_library_result<::HMODULE> safe_get_library [[maybe_unused]] (std::string_view sv) {
         if (auto result = get_library(sv); result != nullptr)
             return { result, false };
         else
@@ -90,10 +145,10 @@ namespace __goldx {
     }
 
     /// __goldx::get_library_info
-    static ::MODULEINFO get_library_info [[maybe_unused]] (::HMODULE hmod) {
+    static library_info get_library_info [[maybe_unused]] (::HMODULE hmod) {
         ::MODULEINFO result;
         ::GetModuleInformation(::GetCurrentProcess(), hmod, &result, sizeof(result));
-        return result;
+        return { result.lpBaseOfDll, result.EntryPoint, result.SizeOfImage };
     }
 
     /// __goldx::get_library_name
@@ -111,26 +166,17 @@ namespace __goldx {
     }
 
     /// __goldx::get_proc_addr
-    static auto get_proc_addr [[maybe_unused]] (::HMODULE hmod, std::string_view fname) {
-        return ::GetProcAddress(hmod, fname.data());
-    }
-
-    /// __goldx::get_storage
-    static auto get_storage [[maybe_unused]] (dl_module_byte_array_ref data) {
-        return dl_module_storage_impl::s_get_(data);
+    static gold::dl_symbol::native_handle_type get_proc_addr [[maybe_unused]] (::HMODULE hmod, std::string_view fname) {
+        return reinterpret_cast<gold::dl_symbol::native_handle_type>(::GetProcAddress(hmod, std::string(fname).c_str()));
     }
 
-    /// __goldx::swap_storage
-    static void swap_storage [[maybe_unused]] (dl_module_byte_array_ref lhs, dl_module_byte_array_ref rhs) {
-        get_storage(lhs)->swap(*get_storage(rhs));
-    }
+    /// __goldx::open_exports
+    static std::unique_ptr<export_table> open_exports [[maybe_unused]] (std::string_view fname, ::HMODULE hmod) {
+        ::LOADED_IMAGE loaded_img;
+        auto result = std::make_unique<export_table>();
+        result->m_handle_ = hmod;
 
-    /// __goldx::get_symbol_names
-    static auto get_symbol_names [[maybe_unused]] (std::string_view fname) {
-        ::LOADED_IMAGE           loaded_img;
-        std::vector<std::string> result;
-
-        if (::MapAndLoad(fname.data(), nullptr, &loaded_img, true, true)) {
+        if (::MapAndLoad(std::string(fname).c_str(), nullptr, &loaded_img, true, true)) {
             auto dir_size    = 0ul;
             auto img_exp_dir = static_cast<::IMAGE_EXPORT_DIRECTORY*>(
                 ::ImageDirectoryEntryToData(
@@ -149,7 +195,7 @@ namespace __goldx {
                     )
                 );
                 for (std::size_t i = 0; i < img_exp_dir->NumberOfNames; ++i) {
-                    result.emplace_back(
+                    result->m_storage_.emplace_back(
                         static_cast<char*>(::ImageRvaToVa(
                             loaded_img.FileHeader,
                             loaded_img.MappedAddress,
@@ -161,30 +207,422 @@ namespace __goldx {
             }
             ::UnMapAndLoad(&loaded_img);
         }
+        result->m_names_.assign(result->m_storage_.begin(), result->m_storage_.end());
+        std::vector<std::uint32_t> positions (result->m_names_.size());
+        for (std::uint32_t i = 0; i < positions.size(); ++i)
+            positions[i] = i;
+        result->m_index_.build(positions, [&](std::size_t i) { return result->m_names_[i]; });
+        return result;
+    }
+
+#else
+
+    /// __goldx::native_library [ as returned by 'dlopen' ]
+    using native_library = void*;
+
+    /// __goldx::load_library
+    static void* load_library [[maybe_unused]] (std::string_view sv) {
+        return ::dlopen(std::string(sv).c_str(), RTLD_NOW | RTLD_LOCAL);
+    }
+
+    /// __goldx::safe_get_library
+    // 'dlopen' reference counts the libraries it has already loaded,
+    // so every successful handle has to be released
+    static safe_gotten_library_result<void*> safe_get_library [[maybe_unused]] (std::string_view sv) {
+        void* result = load_library(sv);
+        return { result, result != nullptr };
+    }
+
+    /// __goldx::free_library
+    static void free_library [[maybe_unused]] (void* handle) {
+        ::dlclose(handle);
+    }
+
+    /// __goldx::get_link_map
+    static const ::link_map* get_link_map [[maybe_unused]] (void* handle) {
+        ::link_map* result = nullptr;
+        if (::dlinfo(handle, RTLD_DI_LINKMAP, &result) != 0)
+            return nullptr;
+        return result;
+    }
+
+    /// __goldx::get_library_image_name
+    static std::string get_library_image_name [[maybe_unused]] (void* handle) {
+        const ::link_map* lm = get_link_map(handle);
+        if (lm == nullptr)
+            return std::string();
+        // the main program has an empty name in the link map
+        if (lm->l_name == nullptr || lm->l_name[0] == '\0') {
+            char temp_out [1024] {};
+            const ::ssize_t n = ::readlink("/proc/self/exe", temp_out, sizeof(temp_out) - 1);
+            return n > 0 ? std::string(temp_out, static_cast<std::size_t>(n)) : std::string();
+        }
+        return std::string(lm->l_name);
+    }
+
+    /// __goldx::get_library_name
+    static std::string get_library_name [[maybe_unused]] (void* handle) {
+        std::string result = get_library_image_name(handle);
+        if (auto pos = result.rfind('/'); pos != std::string::npos)
+            result.erase(0, pos + 1);
+        return result;
+    }
+
+    /// __goldx::get_library_info
+    static library_info get_library_info [[maybe_unused]] (void* handle) {
+        struct search_t {
+            const ::link_map* lm;
+            library_info      info;
+        } search { get_link_map(handle), {} };
+
+        if (search.lm == nullptr)
+            return {};
+
+        ::dl_iterate_phdr(+[](::dl_phdr_info* info, std::size_t, void* data) -> int {
+            auto& s = *static_cast<search_t*>(data);
+            const char* name    = info->dlpi_name != nullptr ? info->dlpi_name : "";
+            const char* lm_name = s.lm->l_name != nullptr ? s.lm->l_name : "";
+            if (info->dlpi_addr != s.lm->l_addr || std::strcmp(name, lm_name) != 0)
+                return 0;
+            ElfW(Addr) lowest = ~ElfW(Addr)(0), highest = 0;
+            for (std::size_t i = 0; i < info->dlpi_phnum; ++i) {
+                const auto& phdr = info->dlpi_phdr[i];
+                if (phdr.p_type != PT_LOAD)
+                    continue;
+                lowest  = std::min(lowest, phdr.p_vaddr);
+                highest = std::max(highest, phdr.p_vaddr + phdr.p_memsz);
+            }
+            if (highest == 0)
+                return 0;
+            const auto* ehdr = reinterpret_cast<const ElfW(Ehdr)*>(info->dlpi_addr + lowest);
+            s.info.base  = ehdr;
+            s.info.size  = highest - lowest;
+            s.info.entry = ehdr->e_entry != 0 ? reinterpret_cast<const void*>(info->dlpi_addr + ehdr->e_entry) : nullptr;
+            return 1;
+        }, &search);
+        return search.info;
+    }
+
+    /// __goldx::get_proc_addr
+    static gold::dl_symbol::native_handle_type get_proc_addr [[maybe_unused]] (void* handle, std::string_view fname) {
+        return reinterpret_cast<gold::dl_symbol::native_handle_type>(::dlsym(handle, std::string(fname).c_str()));
+    }
+
+    /// __goldx::native_elf_class
+    static constexpr unsigned char native_elf_class = __ELF_NATIVE_CLASS == 64 ? ELFCLASS64 : ELFCLASS32;
+
+    /// __goldx::is_exported
+    static bool is_exported [[maybe_unused]] (const ElfW(Sym)& sym) noexcept {
+        if (sym.st_shndx == SHN_UNDEF || sym.st_name == 0)
+            return false;
+        // version definitions show up as absolute symbols at zero
+        if (sym.st_shndx == SHN_ABS && sym.st_value == 0)
+            return false;
+        // both macros are the same for 32-bit and 64-bit images
+        const unsigned char bind = ELF64_ST_BIND(sym.st_info);
+        const unsigned char vis  = ELF64_ST_VISIBILITY(sym.st_other);
+        return (bind == STB_GLOBAL || bind == STB_WEAK || bind == STB_GNU_UNIQUE)
+            && (vis == STV_DEFAULT || vis == STV_PROTECTED);
+    }
+
+    /// __goldx::export_table
+    // a read-only mapping of the image file; names are views into its
+    // '.dynstr' section and live as long as the mapping, and lookups go
+    // through the '.gnu.hash' section of the image whenever it has one
+    struct export_table {
+        using bloom_word = ElfW(Addr);
+
+        static constexpr std::uint32_t s_bloom_bits_ = sizeof(bloom_word) * 8;
+
+        const std::byte*              m_map_          = nullptr;
+        std::size_t                   m_map_size_     = 0;
+        void*                         m_handle_       = nullptr;
+        std::uintptr_t                m_load_bias_    = 0;
+
+        const ElfW(Sym)*              m_syms_         = nullptr;
+        std::size_t                   m_sym_count_    = 0;
+        const char*                   m_strs_         = nullptr;
+        std::size_t                   m_strs_size_    = 0;
+        const ElfW(Half)*             m_versyms_      = nullptr;
+
+        const bloom_word*             m_bloom_        = nullptr;
+        const std::uint32_t*          m_buckets_      = nullptr;
+        const std::uint32_t*          m_chain_        = nullptr;
+        std::uint32_t                 m_bloom_size_   = 0;
+        std::uint32_t                 m_bloom_shift_  = 0;
+        std::uint32_t                 m_bucket_count_ = 0;
+        std::uint32_t                 m_sym_offset_   = 0;
+
+        hashed_index                  m_index_;       // only without '.gnu.hash'
+        std::vector<std::string_view> m_names_;
+        std::once_flag                m_listed_;
+
+        export_table() = default;
+        export_table(const export_table&) = delete;
+        export_table& operator=(const export_table&) = delete;
+
+        ~export_table() {
+            if (m_map_ != nullptr)
+                ::munmap(const_cast<std::byte*>(m_map_), m_map_size_);
+        }
+
+        template <typename T>
+        const T* at(std::size_t offset, std::size_t count = 1) const noexcept {
+            if (offset > m_map_size_ || count > (m_map_size_ - offset) / sizeof(T))
+                return nullptr;
+            return reinterpret_cast<const T*>(m_map_ + offset);
+        }
+
+        std::string_view name_of(std::size_t i) const noexcept {
+            const std::size_t offset = m_syms_[i].st_name;
+            if (offset >= m_strs_size_)
+                return {};
+            const char* first = m_strs_ + offset;
+            const void* last  = std::memchr(first, '\0', m_strs_size_ - offset);
+            return last != nullptr ? std::string_view(first, static_cast<const char*>(last) - first) : std::string_view();
+        }
+
+        // exported and not a hidden version of a versioned symbol
+        bool is_visible(std::size_t i) const noexcept {
+            return is_exported(m_syms_[i]) && (m_versyms_ == nullptr || (m_versyms_[i] & 0x8000) == 0);
+        }
+
+        std::size_t find_index(std::string_view name, std::uint32_t hash) const noexcept {
+            if (m_buckets_ == nullptr) {
+                return m_index_.find(name, hash, [this](std::size_t i) { return name_of(i); });
+            }
+            const bloom_word word = m_bloom_[(hash / s_bloom_bits_) & (m_bloom_size_ - 1)];
+            const bloom_word mask = (bloom_word(1) << (hash % s_bloom_bits_))
+                                  | (bloom_word(1) << ((hash >> m_bloom_shift_) % s_bloom_bits_));
+            if ((word & mask) != mask)
+                return hashed_index::npos;
+            for (std::size_t i = m_buckets_[hash % m_bucket_count_]; i >= m_sym_offset_ && i < m_sym_count_; ++i) {
+                const std::uint32_t chain_hash = m_chain_[i - m_sym_offset_];
+                if ((chain_hash | 1) == (hash | 1) && name_of(i) == name && is_visible(i))
+                    return i;
+                if (chain_hash & 1)
+                    break;
+            }
+            return hashed_index::npos;
+        }
+
+        gold::dl_symbol::native_handle_type find(std::string_view name, std::uint32_t hash) const noexcept {
+            const std::size_t i = find_index(name, hash);
+            if (i == hashed_index::npos)
+                return nullptr;
+            const ElfW(Sym)& sym = m_syms_[i];
+            // both need the loader: resolvers and thread-local blocks
+            const unsigned char type = ELF64_ST_TYPE(sym.st_info);
+            if (type == STT_GNU_IFUNC || type == STT_TLS)
+                return reinterpret_cast<gold::dl_symbol::native_handle_type>(::dlsym(m_handle_, m_strs_ + sym.st_name));
+            return reinterpret_cast<gold::dl_symbol::native_handle_type>(m_load_bias_ + sym.st_value);
+        }
+
+        std::span<const std::string_view> names() {
+            std::call_once(m_listed_, [this] {
+                m_names_.reserve(m_sym_count_);
+                for (std::size_t i = 1; i < m_sym_count_; ++i)
+                    if (is_visible(i))
+                        if (auto name = name_of(i); !name.empty())
+                            m_names_.push_back(name);
+            });
+            return m_names_;
+        }
+    };
+
+    /// __goldx::open_exports
+    // maps the image read-only and locates its dynamic symbol table,
+    // versions, and hash table without copying any of them
+    static std::unique_ptr<export_table> open_exports [[maybe_unused]] (std::string_view fname, void* handle) {
+        auto result = std::make_unique<export_table>();
+        result->m_handle_ = handle;
+        if (const ::link_map* lm = get_link_map(handle))
+            result->m_load_bias_ = lm->l_addr;
+
+        const int fd = ::open(std::string(fname).c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            return result;
+        struct ::stat st {};
+        if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* map = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (map != MAP_FAILED) {
+                result->m_map_      = static_cast<const std::byte*>(map);
+                result->m_map_size_ = static_cast<std::size_t>(st.st_size);
+            }
+        }
+        ::close(fd);
+
+        const auto* ehdr = result->at<ElfW(Ehdr)>(0);
+        if (ehdr == nullptr
+         || std::memcmp(ehdr->e_ident, ELFMAG, SELFMAG) != 0
+         || ehdr->e_ident[EI_CLASS] != native_elf_class
+         || ehdr->e_shentsize != sizeof(ElfW(Shdr)))
+            return result;
+
+        const auto* shdrs = result->at<ElfW(Shdr)>(ehdr->e_shoff, ehdr->e_shnum);
+        if (shdrs == nullptr)
+            return result;
+
+        std::size_t dynsym_index = ehdr->e_shnum;
+        for (std::size_t i = 0; i < ehdr->e_shnum; ++i) {
+            const auto& dynsym = shdrs[i];
+            if (dynsym.sh_type != SHT_DYNSYM || dynsym.sh_link >= ehdr->e_shnum)
+                continue;
+            const auto& dynstr = shdrs[dynsym.sh_link];
+            const std::size_t count = dynsym.sh_size / sizeof(ElfW(Sym));
+            const auto* syms = result->at<ElfW(Sym)>(dynsym.sh_offset, count);
+            const auto* strs = result->at<char>(dynstr.sh_offset, dynstr.sh_size);
+            if (syms == nullptr || strs == nullptr)
+                return result;
+            result->m_syms_      = syms;
+            result->m_sym_count_ = count;
+            result->m_strs_      = strs;
+            result->m_strs_size_ = dynstr.sh_size;
+            dynsym_index = i;
+            break;
+        }
+        if (dynsym_index == ehdr->e_shnum)
+            return result;
+
+        for (std::size_t i = 0; i < ehdr->e_shnum; ++i) {
+            const auto& shdr = shdrs[i];
+            if (shdr.sh_link != dynsym_index)
+                continue;
+            if (shdr.sh_type == SHT_GNU_versym) {
+                result->m_versyms_ = result->at<ElfW(Half)>(shdr.sh_offset, result->m_sym_count_);
+            } else if (shdr.sh_type == SHT_GNU_HASH) {
+                const auto* header = result->at<std::uint32_t>(shdr.sh_offset, 4);
+                if (header == nullptr || header[0] == 0 || header[2] == 0 || (header[2] & (header[2] - 1)) != 0
+                 || header[1] > result->m_sym_count_)
+                    continue;
+                const std::size_t bloom_offset  = shdr.sh_offset + 4 * sizeof(std::uint32_t);
+                const std::size_t bucket_offset = bloom_offset + header[2] * sizeof(export_table::bloom_word);
+                const std::size_t chain_offset  = bucket_offset + header[0] * sizeof(std::uint32_t);
+                const auto* bloom   = result->at<export_table::bloom_word>(bloom_offset, header[2]);
+                const auto* buckets = result->at<std::uint32_t>(bucket_offset, header[0]);
+                const auto* chain   = result->at<std::uint32_t>(chain_offset, result->m_sym_count_ - header[1]);
+                if (bloom == nullptr || buckets == nullptr || chain == nullptr)
+                    continue;
+                result->m_bucket_count_ = header[0];
+                result->m_sym_offset_   = header[1];
+                result->m_bloom_size_   = header[2];
+                result->m_bloom_shift_  = header[3];
+                result->m_bloom_        = bloom;
+                result->m_buckets_      = buckets;
+                result->m_chain_        = chain;
+            }
+        }
+
+        // older images only carry the sysv '.hash' section, index them ourselves
+        if (result->m_buckets_ == nullptr) {
+            auto& table = *result;
+            std::vector<std::uint32_t> visible;
+            for (std::uint32_t i = 1; i < table.m_sym_count_; ++i)
+                if (table.is_visible(i))
+                    visible.push_back(i);
+            table.m_index_.build(visible, [&table](std::size_t i) { return table.name_of(i); });
+        }
         return result;
     }
 
-    /// __goldx::contains_one
-    static bool contains_one(const std::vector<std::string>& vect, std::string_view elem) {
-        for (const std::string& i : vect) {
-            if (i == elem)
-                return true;
+#endif
+
+    /// __goldx::dl_module_storage_impl
+    // the names are set when the module is loaded; the export table and the
+    // symbols are built on first use by whichever thread gets there first
+    // and published once, so concurrent lookups need no lock
+    struct dl_module_storage_impl {
+        std::atomic<export_table*>                  m_exports_ { nullptr };
+        std::atomic<std::vector<gold::dl_symbol>*> m_syms_    { nullptr };
+        std::string                                 m_mod_name_;
+        std::string                                 m_img_name_;
+        bool                                        m_auto_free_ = false;
+        native_library                              m_handle_    = nullptr;
+
+        dl_module_storage_impl() = default;
+
+        ~dl_module_storage_impl() { this->clear_caches(); }
+
+        /// clear_caches [ pre: no lookup is running ]
+        void clear_caches() noexcept {
+            delete m_exports_.exchange(nullptr, std::memory_order_acquire);
+            delete m_syms_.exchange(nullptr, std::memory_order_acquire);
         }
-        return false;
+
+        /// swap [ pre: no lookup is running on either side ]
+        void swap(dl_module_storage_impl& other) noexcept {
+            using std::swap;
+            m_exports_.store(other.m_exports_.exchange(m_exports_.load(std::memory_order_relaxed),
+                             std::memory_order_relaxed), std::memory_order_relaxed);
+            m_syms_.store(other.m_syms_.exchange(m_syms_.load(std::memory_order_relaxed),
+                          std::memory_order_relaxed), std::memory_order_relaxed);
+            swap(m_mod_name_, other.m_mod_name_);
+            swap(m_img_name_, other.m_img_name_);
+            swap(m_auto_free_, other.m_auto_free_);
+            swap(m_handle_, other.m_handle_);
+        }
+
+        static dl_module_storage_impl* s_get_(dl_module_byte_array_ref data) {
+            return std::launder(reinterpret_cast<dl_module_storage_impl*>(data));
+        }
+
+        static dl_module_storage_impl* s_init_(dl_module_byte_array_ref data) {
+             return std::construct_at(s_get_(data));
+        }
+
+        static void s_destroy_(dl_module_byte_array_ref data) {
+            std::destroy_at(s_get_(data));
+        }
+    };
+
+    static_assert(sizeof(dl_module_storage_impl) <= dl_module_storage_max_size);
+    static_assert(alignof(dl_module_storage_impl) <= dl_module_storage_max_align);
+
+    /// __goldx::get_storage
+    static auto get_storage [[maybe_unused]] (dl_module_byte_array_ref data) {
+        return dl_module_storage_impl::s_get_(data);
+    }
+
+    /// __goldx::swap_storage
+    static void swap_storage [[maybe_unused]] (dl_module_byte_array_ref lhs, dl_module_byte_array_ref rhs) {
+        get_storage(lhs)->swap(*get_storage(rhs));
     }
 
+    /// __goldx::publish
+    // installs 'built' unless another thread got there first; either way
+    // returns what is installed
+    template <typename T>
+    static T& publish [[maybe_unused]] (std::atomic<T*>& slot, std::unique_ptr<T> built) {
+        T* expected = nullptr;
+        if (slot.compare_exchange_strong(expected, built.get(), std::memory_order_acq_rel, std::memory_order_acquire))
+            return *built.release();
+        return *expected;
+    }
+
+    /// __goldx::get_exports
+    // opens the export table of the module on first use
+    static export_table& get_exports [[maybe_unused]] (dl_module_storage_impl& storage) {
+        if (export_table* table = storage.m_exports_.load(std::memory_order_acquire))
+            return *table;
+        return publish(storage.m_exports_, open_exports(storage.m_img_name_, storage.m_handle_));
+    }
 
 } // namespace __goldx
 
 namespace gold {
 
     /// dl_module ctors
-    dl_module::dl_module(std::string_view name) {
-        auto [handle, auto_free] = __goldx::safe_get_library(name);
+    dl_module::dl_module() noexcept {
         __goldx::dl_module_storage_impl::s_init_(m_data_);
+    }
+
+    dl_module::dl_module(std::string_view name) : dl_module() {
+        auto [handle, auto_free] = __goldx::safe_get_library(name);
         auto* m_data_ptr_ = __goldx::get_storage(m_data_);
         m_data_ptr_->m_handle_    = handle;
         m_data_ptr_->m_auto_free_ = auto_free;
+        m_data_ptr_->m_mod_name_  = __goldx::get_library_name(handle);
+        m_data_ptr_->m_img_name_  = __goldx::get_library_image_name(handle);
     }
 
     dl_module::dl_module(dl_module&& other) noexcept : dl_module() {
@@ -221,12 +659,13 @@ namespace gold {
     void dl_module::reset() {
         if (this->has_value()) {
             auto* m_data_ptr_ = __goldx::get_storage(m_data_);
+            const bool auto_free = m_data_ptr_->m_auto_free_;
             m_data_ptr_->m_auto_free_ = false;
-            m_data_ptr_->m_sym_names_.clear();
-            m_data_ptr_->m_syms_.clear();
+            m_data_ptr_->clear_caches();
             m_data_ptr_->m_mod_name_.clear();
             m_data_ptr_->m_img_name_.clear();
-            __goldx::free_library(m_data_ptr_->m_handle_);
+            if (auto_free)
+                __goldx::free_library(m_data_ptr_->m_handle_);
             m_data_ptr_->m_handle_ = nullptr;
         }
     }
@@ -238,17 +677,17 @@ namespace gold {
 
     /// base_address
     const void* dl_module::base_address() const {
-        return __goldx::get_library_info(__goldx::get_storage(const_cast<dl_module*>(this)->m_data_)->m_handle_).lpBaseOfDll;
+        return __goldx::get_library_info(__goldx::get_storage(const_cast<dl_module*>(this)->m_data_)->m_handle_).base;
     }
 
     /// entry_point_address
     const void* dl_module::entry_point_address() const {
-        return __goldx::get_library_info(__goldx::get_storage(const_cast<dl_module*>(this)->m_data_)->m_handle_).EntryPoint;
+        return __goldx::get_library_info(__goldx::get_storage(const_cast<dl_module*>(this)->m_data_)->m_handle_).entry;
     }
 
     /// size
     std::size_t dl_module::size() const {
-        return __goldx::get_library_info(__goldx::get_storage(const_cast<dl_module*>(this)->m_data_)->m_handle_).SizeOfImage;
+        return __goldx::get_library_info(__goldx::get_storage(const_cast<dl_module*>(this)->m_data_)->m_handle_).size;
     }
 
     /// name
@@ -256,42 +695,21 @@ namespace gold {
 
     /// module_name
     std::string_view dl_module::module_name() const {
-        if (!this->has_value())
-            return "";
-
-        auto* m_data_ptr_ = __goldx::get_storage(const_cast<dl_module*>(this)->m_data_);
-
-        if (m_data_ptr_->m_mod_name_.empty()) {
-            m_data_ptr_->m_mod_name_ = __goldx::get_library_name(m_data_ptr_->m_handle_);
-        }
-
-        return m_data_ptr_->m_mod_name_;
+        return __goldx::get_storage(const_cast<dl_module*>(this)->m_data_)->m_mod_name_;
     }
 
     /// image_name
     std::string_view dl_module::image_name() const {
-        if (!this->has_value())
-            return "";
-
-        auto* m_data_ptr_ = __goldx::get_storage(const_cast<dl_module*>(this)->m_data_);
-
-        if (m_data_ptr_->m_img_name_.empty()) {
-            m_data_ptr_->m_img_name_ = __goldx::get_library_image_name(m_data_ptr_->m_handle_);
-        }
-
-        return m_data_ptr_->m_img_name_;
+        return __goldx::get_storage(const_cast<dl_module*>(this)->m_data_)->m_img_name_;
     }
 
     /// symbol_names
-    std::span<const std::string> dl_module::symbol_names() const {
+    std::span<const std::string_view> dl_module::symbol_names() const {
         if (!this->has_value())
             return {};
 
         auto* m_data_ptr_ = __goldx::get_storage(const_cast<dl_module*>(this)->m_data_);
-        if (m_data_ptr_->m_sym_names_.empty()) {
-            m_data_ptr_->m_sym_names_ = __goldx::get_symbol_names(this->image_name());
-        }
-        return std::span<const std::string>{m_data_ptr_->m_sym_names_};
+        return __goldx::get_exports(*m_data_ptr_).names();
     }
 
     /// symbols
@@ -300,25 +718,26 @@ namespace gold {
             return {};
 
         auto* m_data_ptr_ = __goldx::get_storage(const_cast<dl_module*>(this)->m_data_);
-        if (m_data_ptr_->m_syms_.empty()) {
-            m_data_ptr_->m_syms_ = [&] {
-                auto transform_f = std::views::transform([this](std::string_view sv) { return this->symbol(sv); });
-                auto result      = this->symbol_names() | transform_f;
-                return std::vector(result.begin(), result.end());
-            }();
-        }
-        return std::span{m_data_ptr_->m_syms_};
+        if (auto* syms = m_data_ptr_->m_syms_.load(std::memory_order_acquire))
+            return std::span{*syms};
+        auto transform_f = std::views::transform([this](std::string_view sv) { return this->symbol(sv); });
+        auto result      = this->symbol_names() | transform_f;
+        return std::span{__goldx::publish(m_data_ptr_->m_syms_,
+                                          std::make_unique<std::vector<gold::dl_symbol>>(result.begin(), result.end()))};
     }
 
     /// symbol
     gold::dl_symbol dl_module::symbol(std::string_view name) const {
+        return this->symbol(name, gold::dl_symbol_hash(name));
+    }
+
+    gold::dl_symbol dl_module::symbol(std::string_view name, std::uint32_t hash) const {
         if (!this->has_value())
             return nullptr;
         auto* m_data_ptr_ = __goldx::get_storage(const_cast<dl_module*>(this)->m_data_);
-        if (!m_data_ptr_->m_sym_names_.empty()) {
-            if (!__goldx::contains_one(m_data_ptr_->m_sym_names_, name))
-                throw dynamic_library_error("the symbol name requested does not belong to this module");
-        }
+        if (auto result = __goldx::get_exports(*m_data_ptr_).find(name, hash))
+            return result;
+        // not exported by the module itself, but possibly by one of its dependencies
         return __goldx::get_proc_addr(m_data_ptr_->m_handle_, name);
     }
 
@@ -0,0 +1,236 @@
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <vector>
+#include <gold/frame_pool>
+
+namespace gold::__coro {
+
+    /// __coro::s_chunk_size_ [ chunks are aligned to their size ]
+    constexpr std::size_t s_chunk_size_ = 64 * 1024;
+
+    /// __coro::s_class_step_ [ size classes are multiples of it ]
+    constexpr std::size_t s_class_step_ = 32;
+
+    /// __coro::s_class_count_
+    constexpr std::size_t s_class_count_ = 64;
+
+    /// __coro::s_max_block_
+    constexpr std::size_t s_max_block_ = s_class_step_ * s_class_count_;
+
+    /// __coro::s_chunk_header_size_ [ blocks start after it ]
+    constexpr std::size_t s_chunk_header_size_ = 64;
+
+    struct thread_cache;
+
+    /// __coro::free_block
+    struct free_block {
+        free_block* m_next_;
+    };
+
+    /// __coro::chunk_header [ at the start of every chunk ]
+    struct chunk_header {
+        thread_cache* m_owner_;
+    };
+
+    /// __coro::size_class
+    struct size_class {
+        free_block*              m_free_   = nullptr; // owner only
+        std::byte*               m_bump_   = nullptr; // owner only, uncarved part of the newest chunk
+        std::byte*               m_end_    = nullptr;
+        std::atomic<free_block*> m_remote_ { nullptr }; // pushed by other threads
+    };
+
+    /// __coro::counter [ written by one thread, read by any ]
+    struct counter {
+        std::atomic<std::size_t> m_value_ { 0 };
+
+        void add(std::size_t n = 1) noexcept {
+            m_value_.store(m_value_.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+        }
+
+        /// add_shared [ when any thread may write it ]
+        void add_shared(std::size_t n = 1) noexcept {
+            m_value_.fetch_add(n, std::memory_order_relaxed);
+        }
+
+        std::size_t get() const noexcept { return m_value_.load(std::memory_order_relaxed); }
+    };
+
+    /// __coro::thread_cache
+    // the pool of one thread; when the thread exits it is handed over to the
+    // next thread that needs one, so chunks and pending remote frees are
+    // never lost and never need to be reclaimed
+    struct thread_cache {
+        size_class m_classes_[s_class_count_];
+
+        counter m_allocations_;
+        counter m_deallocations_;
+        counter m_remote_deallocations_; // of this cache's blocks, by other threads
+        counter m_large_allocations_;
+        counter m_chunks_;
+
+        frame_pool_stats stats() const noexcept {
+            return {
+                .allocations          = m_allocations_.get(),
+                .deallocations        = m_deallocations_.get(),
+                .remote_deallocations = m_remote_deallocations_.get(),
+                .large_allocations    = m_large_allocations_.get(),
+                .chunks               = m_chunks_.get(),
+                .bytes_reserved       = m_chunks_.get() * s_chunk_size_
+            };
+        }
+    };
+
+    /// __coro::registry
+    struct registry {
+        std::mutex                 m_mtx_;
+        std::vector<thread_cache*> m_caches_;  // every cache ever created
+        std::vector<thread_cache*> m_orphans_; // caches of exited threads
+    };
+
+    /// __coro::s_registry_
+    registry& s_registry_() {
+        static registry* result = new registry; // outlives every thread_local
+        return *result;
+    }
+
+    /// __coro::t_cache_
+    thread_local constinit thread_cache* t_cache_ = nullptr;
+
+    /// __coro::cache_holder [ hands the cache over when the thread exits ]
+    struct cache_holder {
+        bool m_active_ = false;
+
+        ~cache_holder() {
+            if (t_cache_ != nullptr) {
+                auto& reg = s_registry_();
+                std::lock_guard guard (reg.m_mtx_);
+                reg.m_orphans_.push_back(t_cache_);
+            }
+            t_cache_ = nullptr;
+        }
+    };
+
+    thread_local cache_holder t_holder_;
+
+    /// __coro::acquire_cache [ adopts an orphan if there is one ]
+    [[gnu::noinline]] thread_cache& acquire_cache() {
+        auto& reg = s_registry_();
+        {
+            std::lock_guard guard (reg.m_mtx_);
+            if (!reg.m_orphans_.empty()) {
+                t_cache_ = reg.m_orphans_.back();
+                reg.m_orphans_.pop_back();
+            } else {
+                t_cache_ = new thread_cache;
+                reg.m_caches_.push_back(t_cache_);
+            }
+        }
+        t_holder_.m_active_ = true;
+        return *t_cache_;
+    }
+
+    thread_cache& current_cache() {
+        if (t_cache_ != nullptr) [[likely]]
+            return *t_cache_;
+        return acquire_cache();
+    }
+
+    constexpr std::size_t class_of(std::size_t bytes) noexcept {
+        return (bytes + s_class_step_ - 1) / s_class_step_ - 1;
+    }
+
+    chunk_header* chunk_of(void* ptr) noexcept {
+        return reinterpret_cast<chunk_header*>(reinterpret_cast<std::uintptr_t>(ptr) & ~(s_chunk_size_ - 1));
+    }
+
+    /// __coro::refill [ pre: the free list of 'sc' is empty ]
+    [[gnu::noinline]] void* refill(thread_cache& cache, size_class& sc, std::size_t block) {
+        // blocks freed by other threads come back first
+        if (free_block* remote = sc.m_remote_.exchange(nullptr, std::memory_order_acquire)) {
+            sc.m_free_ = remote->m_next_;
+            return remote;
+        }
+        if (sc.m_bump_ == nullptr || sc.m_end_ - sc.m_bump_ < static_cast<std::ptrdiff_t>(block)) {
+            auto* chunk = static_cast<std::byte*>(::operator new(s_chunk_size_, std::align_val_t(s_chunk_size_)));
+            ::new (chunk) chunk_header { &cache };
+            sc.m_bump_ = chunk + s_chunk_header_size_;
+            sc.m_end_  = chunk + s_chunk_size_;
+            cache.m_chunks_.add();
+        }
+        void* result = sc.m_bump_;
+        sc.m_bump_ += block;
+        return result;
+    }
+
+    /// __coro::frame_pool_allocate
+    void* frame_pool_allocate(std::size_t bytes) {
+        if (bytes > s_max_block_ || bytes == 0) [[unlikely]] {
+            current_cache().m_large_allocations_.add();
+            return ::operator new(bytes);
+        }
+
+        thread_cache& cache = current_cache();
+        const std::size_t index = class_of(bytes);
+        size_class& sc = cache.m_classes_[index];
+        cache.m_allocations_.add();
+
+        if (free_block* block = sc.m_free_) [[likely]] {
+            sc.m_free_ = block->m_next_;
+            return block;
+        }
+        return refill(cache, sc, (index + 1) * s_class_step_);
+    }
+
+    /// __coro::frame_pool_deallocate
+    void frame_pool_deallocate(void* ptr, std::size_t bytes) noexcept {
+        if (bytes > s_max_block_ || bytes == 0) [[unlikely]] {
+            ::operator delete(ptr, bytes);
+            return;
+        }
+
+        thread_cache* owner = chunk_of(ptr)->m_owner_;
+        size_class& sc = owner->m_classes_[class_of(bytes)];
+        auto* block = static_cast<free_block*>(ptr);
+
+        if (owner == t_cache_) [[likely]] {
+            block->m_next_ = sc.m_free_;
+            sc.m_free_ = block;
+            owner->m_deallocations_.add();
+            return;
+        }
+
+        // only the owner takes the list, and it takes all of it, so a plain
+        // push cannot suffer from ABA
+        free_block* head = sc.m_remote_.load(std::memory_order_relaxed);
+        do {
+            block->m_next_ = head;
+        } while (!sc.m_remote_.compare_exchange_weak(head, block, std::memory_order_release, std::memory_order_relaxed));
+        owner->m_remote_deallocations_.add_shared();
+    }
+
+    /// __coro::frame_pool_thread_stats
+    frame_pool_stats frame_pool_thread_stats() noexcept {
+        return t_cache_ != nullptr ? t_cache_->stats() : frame_pool_stats{};
+    }
+
+    /// __coro::frame_pool_global_stats
+    frame_pool_stats frame_pool_global_stats() noexcept {
+        frame_pool_stats result;
+        auto& reg = s_registry_();
+        std::lock_guard guard (reg.m_mtx_);
+        for (const thread_cache* cache : reg.m_caches_) {
+            const frame_pool_stats s = cache->stats();
+            result.allocations          += s.allocations;
+            result.deallocations        += s.deallocations;
+            result.remote_deallocations += s.remote_deallocations;
+            result.large_allocations    += s.large_allocations;
+            result.chunks               += s.chunks;
+            result.bytes_reserved       += s.bytes_reserved;
+        }
+        return result;
+    }
+
+} // namespace gold::__coro
@@ -0,0 +1,349 @@
+#include <cerrno>
+#include <cstdint>
+#include <gold/io_context>
+
+#if defined(__linux__)
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace gold::__io {
+
+    /// __io::fd_state
+    struct fd_state {
+        std::mutex m_mtx_;
+        int        m_fd_;
+        operation* m_reader_ = nullptr;
+        operation* m_writer_ = nullptr;
+        bool       m_added_  = false; // known to the epoll instance
+
+        explicit fd_state(int fd) noexcept : m_fd_(fd) {}
+    };
+
+    /// __io::would_block
+    bool would_block(int error) noexcept {
+        return error == EAGAIN || error == EWOULDBLOCK;
+    }
+
+    /// __io::operation::await_suspend
+    bool operation::await_suspend(std::coroutine_handle<> coro) {
+        m_coro_ = coro;
+        return m_ctx_->mf_wait_(*this);
+    }
+
+    /// __io::read_awaiter::sf_perform_
+    bool read_awaiter::sf_perform_(operation& base) noexcept {
+        auto& op = static_cast<read_awaiter&>(base);
+        for (;;) {
+            const ::ssize_t n = ::read(op.m_fd_, op.m_data_, op.m_size_);
+            if (n >= 0) {
+                op.m_result_ = static_cast<std::size_t>(n);
+                return true;
+            }
+            if (errno != EINTR) {
+                if (would_block(errno))
+                    return false;
+                op.m_error_ = errno;
+                return true;
+            }
+        }
+    }
+
+    /// __io::write_awaiter::sf_perform_
+    bool write_awaiter::sf_perform_(operation& base) noexcept {
+        auto& op = static_cast<write_awaiter&>(base);
+        for (;;) {
+            const ::ssize_t n = ::write(op.m_fd_, op.m_data_, op.m_size_);
+            if (n >= 0) {
+                op.m_result_ = static_cast<std::size_t>(n);
+                return true;
+            }
+            if (errno != EINTR) {
+                if (would_block(errno))
+                    return false;
+                op.m_error_ = errno;
+                return true;
+            }
+        }
+    }
+
+    /// __io::accept_awaiter::sf_perform_
+    bool accept_awaiter::sf_perform_(operation& op) noexcept {
+        for (;;) {
+            const int fd = ::accept4(op.m_fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd >= 0) {
+                op.m_result_ = static_cast<std::size_t>(fd);
+                return true;
+            }
+            if (errno != EINTR) {
+                // the peer may have given up before we got to it
+                if (would_block(errno) || errno == ECONNABORTED)
+                    return false;
+                op.m_error_ = errno;
+                return true;
+            }
+        }
+    }
+
+    /// __io::connect_awaiter::sf_perform_
+    bool connect_awaiter::sf_perform_(operation& base) noexcept {
+        auto& op = static_cast<connect_awaiter&>(base);
+        if (!op.m_started_) {
+            op.m_started_ = true;
+            if (::connect(op.m_fd_, op.m_addr_, op.m_addr_len_) == 0)
+                return true;
+            if (errno == EINPROGRESS || errno == EINTR)
+                return false;
+            op.m_error_ = errno;
+            return true;
+        }
+        int error = 0;
+        ::socklen_t len = sizeof(error);
+        if (::getsockopt(op.m_fd_, SOL_SOCKET, SO_ERROR, &error, &len) != 0)
+            error = errno;
+        op.m_error_ = error;
+        return true;
+    }
+
+} // namespace gold::__io
+
+namespace gold {
+
+    /// io_context ctors
+    io_context::io_context()
+    : m_timers_(std::chrono::milliseconds(1), [this] { this->mf_wake_(); }) {
+        m_epoll_ = ::epoll_create1(EPOLL_CLOEXEC);
+        if (m_epoll_ < 0)
+            throw io_error(errno, "io_context: epoll_create1");
+
+        m_wake_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (m_wake_fd_ < 0) {
+            const int error = errno;
+            ::close(m_epoll_);
+            throw io_error(error, "io_context: eventfd");
+        }
+
+        ::epoll_event ev {};
+        ev.events   = EPOLLIN;
+        ev.data.ptr = nullptr;
+        if (::epoll_ctl(m_epoll_, EPOLL_CTL_ADD, m_wake_fd_, &ev) != 0) {
+            const int error = errno;
+            ::close(m_wake_fd_);
+            ::close(m_epoll_);
+            throw io_error(error, "io_context: epoll_ctl");
+        }
+    }
+
+    io_context::io_context(thread_pool& pool) : io_context() {
+        m_pool_ = &pool;
+    }
+
+    /// io_context dtor
+    io_context::~io_context() {
+        ::close(m_wake_fd_);
+        ::close(m_epoll_);
+    }
+
+    /// mf_wake_ [ interrupts 'epoll_wait' ]
+    void io_context::mf_wake_() noexcept {
+        const std::uint64_t one = 1;
+        [[maybe_unused]] const auto n = ::write(m_wake_fd_, &one, sizeof(one));
+    }
+
+    /// mf_post_
+    void io_context::mf_post_(std::coroutine_handle<> coro) {
+        {
+            std::lock_guard guard (m_post_mtx_);
+            m_posted_.push_back(coro);
+        }
+        this->mf_wake_();
+    }
+
+    /// mf_dispatch_
+    void io_context::mf_dispatch_(std::coroutine_handle<> coro) {
+        if (m_pool_ != nullptr)
+            m_pool_->enqueue(coro);
+        else
+            coro.resume();
+    }
+
+    /// mf_next_timeout_ [ milliseconds for 'epoll_wait', rounded up ]
+    int io_context::mf_next_timeout_() {
+        const auto next = m_timers_.next_expiry();
+        if (!next)
+            return -1;
+        const auto left = *next - clock::now();
+        if (left <= clock::duration::zero())
+            return 0;
+        return static_cast<int>(std::chrono::ceil<std::chrono::milliseconds>(left).count());
+    }
+
+    /// mf_state_
+    __io::fd_state& io_context::mf_state_(int fd) {
+        std::lock_guard guard (m_fds_mtx_);
+        const auto index = static_cast<std::size_t>(fd);
+        if (index >= m_fds_.size())
+            m_fds_.resize(index + 1);
+        if (!m_fds_[index])
+            m_fds_[index] = std::make_unique<__io::fd_state>(fd);
+        return *m_fds_[index];
+    }
+
+    namespace __io {
+
+        /// __io::arm [ pre: the lock of 'state' is held ]
+        int arm(int epoll, fd_state& state) noexcept {
+            ::epoll_event ev {};
+            ev.events   = EPOLLONESHOT;
+            ev.data.ptr = &state;
+            if (state.m_reader_ != nullptr)
+                ev.events |= EPOLLIN | EPOLLRDHUP;
+            if (state.m_writer_ != nullptr)
+                ev.events |= EPOLLOUT;
+
+            // the descriptor number may have been closed and reused since
+            // it was last added, in which case the kernel no longer knows it
+            if (state.m_added_ && ::epoll_ctl(epoll, EPOLL_CTL_MOD, state.m_fd_, &ev) == 0)
+                return 0;
+            if (state.m_added_ && errno != ENOENT)
+                return errno;
+            if (::epoll_ctl(epoll, EPOLL_CTL_ADD, state.m_fd_, &ev) != 0)
+                return errno;
+            state.m_added_ = true;
+            return 0;
+        }
+
+    } // namespace __io
+
+    /// mf_wait_ [ false if the operation completed, with an error, without waiting ]
+    bool io_context::mf_wait_(__io::operation& op) {
+        __io::fd_state& state = this->mf_state_(op.m_fd_);
+        std::lock_guard guard (state.m_mtx_);
+        (op.m_write_ ? state.m_writer_ : state.m_reader_) = &op;
+        if (const int error = __io::arm(m_epoll_, state); error != 0) {
+            (op.m_write_ ? state.m_writer_ : state.m_reader_) = nullptr;
+            op.m_error_ = error;
+            return false;
+        }
+        return true;
+    }
+
+    /// run
+    void io_context::run() {
+        constexpr int max_events = 128;
+        ::epoll_event events[max_events];
+        std::vector<std::coroutine_handle<>> ready;
+
+        while (!m_stopped_.load(std::memory_order_acquire)) {
+            const int n = ::epoll_wait(m_epoll_, events, max_events, this->mf_next_timeout_());
+            if (n < 0 && errno != EINTR)
+                throw io_error(errno, "io_context: epoll_wait");
+
+            for (int i = 0; i < n; ++i) {
+                if (events[i].data.ptr == nullptr) {
+                    std::uint64_t count;
+                    [[maybe_unused]] const auto r = ::read(m_wake_fd_, &count, sizeof(count));
+                    continue;
+                }
+
+                auto& state = *static_cast<__io::fd_state*>(events[i].data.ptr);
+                const std::uint32_t ev = events[i].events;
+                const bool failed = (ev & (EPOLLERR | EPOLLHUP)) != 0;
+
+                std::lock_guard guard (state.m_mtx_);
+                // an operation completing here must not be touched once its
+                // coroutine is handed over, hence the copy of 'm_coro_'
+                auto perform = [&](__io::operation*& slot, std::uint32_t mask) {
+                    if (slot != nullptr && ((ev & mask) != 0 || failed) && slot->m_perform_(*slot)) {
+                        ready.push_back(slot->m_coro_);
+                        slot = nullptr;
+                    }
+                };
+                perform(state.m_reader_, EPOLLIN | EPOLLRDHUP);
+                perform(state.m_writer_, EPOLLOUT);
+
+                if (state.m_reader_ != nullptr || state.m_writer_ != nullptr) {
+                    if (const int error = __io::arm(m_epoll_, state); error != 0) {
+                        for (auto* slot : { &state.m_reader_, &state.m_writer_ }) {
+                            if (*slot != nullptr) {
+                                (*slot)->m_error_ = error;
+                                ready.push_back((*slot)->m_coro_);
+                                *slot = nullptr;
+                            }
+                        }
+                    }
+                }
+            }
+
+            // expired sleepers are dispatched straight from the wheel
+            m_timers_.advance();
+
+            {
+                std::lock_guard guard (m_post_mtx_);
+                ready.insert(ready.end(), m_posted_.begin(), m_posted_.end());
+                m_posted_.clear();
+            }
+
+            for (auto coro : ready)
+                this->mf_dispatch_(coro);
+            ready.clear();
+        }
+    }
+
+    /// stop
+    void io_context::stop() noexcept {
+        m_stopped_.store(true, std::memory_order_release);
+        this->mf_wake_();
+    }
+
+} // namespace gold
+
+#else
+
+namespace gold::__io {
+
+    /// __io::fd_state [ never created ]
+    struct fd_state {};
+
+    // epoll and eventfd are linux-only; no 'io_context' can be constructed,
+    // so none of these is ever reached
+
+    bool operation::await_suspend(std::coroutine_handle<>) { return false; }
+
+    bool read_awaiter::sf_perform_(operation&) noexcept { return true; }
+
+    bool write_awaiter::sf_perform_(operation&) noexcept { return true; }
+
+    bool accept_awaiter::sf_perform_(operation&) noexcept { return true; }
+
+    bool connect_awaiter::sf_perform_(operation&) noexcept { return true; }
+
+} // namespace gold::__io
+
+namespace gold {
+
+    io_context::io_context() {
+        throw io_error(ENOSYS, "io_context: not supported on this platform");
+    }
+
+    io_context::io_context(thread_pool& pool) : io_context() {
+        m_pool_ = &pool;
+    }
+
+    io_context::~io_context() = default;
+
+    void io_context::mf_wake_() noexcept {}
+
+    void io_context::mf_post_(std::coroutine_handle<>) {}
+
+    void io_context::mf_dispatch_(std::coroutine_handle<>) {}
+
+    void io_context::run() {}
+
+    void io_context::stop() noexcept {}
+
+} // namespace gold
+
+#endif // __linux__
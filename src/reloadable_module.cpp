@@ -0,0 +1,218 @@
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <gold/reloadable_module>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#endif
+
+namespace gold::__reload {
+
+    /// __reload::s_max_readers_
+    constexpr std::size_t s_max_readers_ = 512;
+
+    /// __reload::s_slots_
+    constinit reader_slot s_slots_[s_max_readers_];
+
+    /// __reload::slot_guard [ gives the slot back when the thread exits ]
+    struct slot_guard {
+        reader_slot* m_slot_ = nullptr;
+
+        ~slot_guard() {
+            if (m_slot_ != nullptr) {
+                m_slot_->m_epoch_.store(0, std::memory_order_relaxed);
+                m_slot_->m_depth_ = 0;
+                m_slot_->m_used_.store(false, std::memory_order_release);
+            }
+        }
+    };
+
+    thread_local slot_guard t_slot_;
+
+    /// __reload::thread_slot
+    reader_slot& thread_slot() {
+        if (t_slot_.m_slot_ != nullptr)
+            return *t_slot_.m_slot_;
+        for (auto& slot : s_slots_) {
+            bool expected = false;
+            if (!slot.m_used_.load(std::memory_order_relaxed)
+             && slot.m_used_.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                t_slot_.m_slot_ = &slot;
+                return slot;
+            }
+        }
+        throw dynamic_library_error("reloadable_module: too many reading threads");
+    }
+
+    /// __reload::oldest_reader
+    // the epoch the oldest active reader entered at, or 'fallback' if none
+    std::uint64_t oldest_reader(std::uint64_t fallback) noexcept {
+        std::uint64_t result = fallback;
+        for (auto& slot : s_slots_) {
+            const std::uint64_t epoch = slot.m_epoch_.load(std::memory_order_seq_cst);
+            if (epoch != 0 && epoch < result)
+                result = epoch;
+        }
+        return result;
+    }
+
+#if !defined(_WIN32)
+
+    /// __reload::copy_to
+    // creates a file from 'templ' [ see 'mkstemp' ] holding the bytes of
+    // 'src'; returns its path, or an empty string if it could not
+    std::string copy_to(int src, std::string templ) {
+        const int dst = ::mkstemp(templ.data());
+        if (dst < 0)
+            return {};
+        bool ok = ::lseek(src, 0, SEEK_SET) == 0 && ::fchmod(dst, S_IRWXU) == 0;
+        char buffer[64 * 1024];
+        while (ok) {
+            const ::ssize_t n = ::read(src, buffer, sizeof(buffer));
+            if (n <= 0) {
+                ok = n == 0;
+                break;
+            }
+            for (::ssize_t done = 0; ok && done < n; ) {
+                const ::ssize_t written = ::write(dst, buffer + done, static_cast<std::size_t>(n - done));
+                ok = written > 0;
+                done += written;
+            }
+        }
+        ok = ::close(dst) == 0 && ok;
+        if (!ok) {
+            ::unlink(templ.c_str());
+            return {};
+        }
+        return templ;
+    }
+
+    /// __reload::private_copy
+    // the loader hands out the handle it already has for a path that is
+    // still loaded, so a generation pinned by a reader would be "reloaded"
+    // as itself. every generation is loaded from a copy of its own, put
+    // next to the original so that '$ORIGIN' still resolves, or in the
+    // temporary directory if that one is not writable. the copy is removed
+    // once loaded and indexed; the mappings keep its contents
+    class private_copy {
+      private:
+        std::string m_path_;
+
+      public:
+        explicit private_copy(std::string_view path) {
+            const std::string source (path);
+            const int src = ::open(source.c_str(), O_RDONLY | O_CLOEXEC);
+            if (src < 0)
+                throw dynamic_library_error("reloadable_module: failed to open the module");
+            m_path_ = copy_to(src, source + ".reload-XXXXXX");
+            if (m_path_.empty()) {
+                const char* tmp = std::getenv("TMPDIR");
+                const std::string base = source.substr(source.rfind('/') + 1);
+                m_path_ = copy_to(src, std::string(tmp != nullptr && tmp[0] != '\0' ? tmp : "/tmp") + "/" + base + ".reload-XXXXXX");
+            }
+            ::close(src);
+            if (m_path_.empty())
+                throw dynamic_library_error("reloadable_module: failed to copy the module");
+        }
+
+        private_copy(const private_copy&) = delete;
+        private_copy& operator=(const private_copy&) = delete;
+
+        ~private_copy() { ::unlink(m_path_.c_str()); }
+
+        const std::string& path() const noexcept { return m_path_; }
+    };
+
+#else
+
+    /// __reload::private_copy [ loads the module in place ]
+    class private_copy {
+      private:
+        std::string m_path_;
+
+      public:
+        explicit private_copy(std::string_view path) : m_path_(path) {}
+
+        const std::string& path() const noexcept { return m_path_; }
+    };
+
+#endif
+
+    /// __reload::load
+    // 'current' is the generation being replaced, if any
+    std::unique_ptr<generation> load(std::string_view path, std::uint64_t id, const generation* current) {
+        const private_copy copy (path);
+        auto result = std::make_unique<generation>(gold::dl_module(copy.path()), id);
+        if (!result->m_module_)
+            throw dynamic_library_error("reloadable_module: failed to load the module");
+        if (current != nullptr && result->m_module_.base_address() == current->m_module_.base_address())
+            throw dynamic_library_error("reloadable_module: the loader returned the current generation");
+        // builds the export index while the file is still there
+        result->m_module_.symbol_names();
+        return result;
+    }
+
+} // namespace gold::__reload
+
+namespace gold {
+
+    /// reloadable_module ctors
+    reloadable_module::reloadable_module(std::string_view path) {
+        m_current_.store(__reload::load(path, m_next_id_++, nullptr).release(), std::memory_order_release);
+    }
+
+    /// reloadable_module dtor
+    reloadable_module::~reloadable_module() {
+        std::lock_guard guard (m_mtx_);
+        this->mf_reclaim_(true);
+        // readers must not outlive the module itself
+        delete m_current_.load(std::memory_order_relaxed);
+    }
+
+    /// mf_reclaim_ [ pre: m_mtx_ is held ]
+    void reloadable_module::mf_reclaim_(bool wait) {
+        while (!m_retired_.empty()) {
+            // a reader that entered at or after a retirement epoch can only
+            // have seen the generations published after it
+            const std::uint64_t oldest = __reload::oldest_reader(__reload::s_epoch_.load(std::memory_order_seq_cst));
+            std::erase_if(m_retired_, [oldest](const retired& r) { return r.m_epoch_ <= oldest; });
+            if (!wait || m_retired_.empty())
+                return;
+            std::this_thread::yield();
+        }
+    }
+
+    /// reload
+    std::uint64_t reloadable_module::reload(std::string_view path) {
+        std::lock_guard guard (m_mtx_);
+        auto next = __reload::load(path, m_next_id_, m_current_.load(std::memory_order_relaxed));
+        ++m_next_id_;
+        const std::uint64_t id = next->m_id_;
+        std::unique_ptr<__reload::generation> previous (m_current_.exchange(next.release(), std::memory_order_seq_cst));
+        const std::uint64_t epoch = __reload::s_epoch_.fetch_add(1, std::memory_order_seq_cst) + 1;
+        m_retired_.push_back({ std::move(previous), epoch });
+        this->mf_reclaim_(false);
+        return id;
+    }
+
+    /// synchronize
+    void reloadable_module::synchronize() {
+        std::lock_guard guard (m_mtx_);
+        this->mf_reclaim_(true);
+    }
+
+    /// generation
+    std::uint64_t reloadable_module::generation() const {
+        return this->read().generation();
+    }
+
+    /// pending
+    std::size_t reloadable_module::pending() const {
+        std::lock_guard guard (m_mtx_);
+        return m_retired_.size();
+    }
+
+} // namespace gold
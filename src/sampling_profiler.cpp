@@ -0,0 +1,591 @@
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <gold/sampling_profiler>
+#include <gold/format>
+
+#if defined(__linux__)
+
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+
+/// requires additional linking '-lrt' on glibc older than 2.17
+
+#ifndef sigev_notify_thread_id
+# define sigev_notify_thread_id _sigev_un._tid
+#endif
+
+namespace gold::__profiler {
+
+    /// __profiler::pc_type
+    using pc_type = stacktrace_entry::native_handle_type;
+
+    /// __profiler::thread_ring
+    // single-producer [SIGPROF handler] single-consumer [collector] ring of
+    // fixed-size samples; each sample is '[depth, pc_0, ..., pc_{depth - 1}]'
+    struct thread_ring {
+        std::atomic<bool>          m_active_  { false };
+        std::atomic<std::uint32_t> m_head_    { 0 };
+        std::atomic<std::uint32_t> m_tail_    { 0 };
+        std::atomic<std::size_t>   m_dropped_ { 0 };
+        std::uint32_t              m_capacity_ = 0; // power of two
+        std::uint32_t              m_stride_   = 0; // 1 + max depth
+        std::unique_ptr<pc_type[]> m_slots_;
+        ::timer_t                  m_timer_ {};
+        bool                       m_has_timer_ = false;
+        ::pid_t                    m_tid_ = 0;
+        struct state*              m_owner_ = nullptr;
+
+        pc_type* slot(std::uint32_t i) noexcept {
+            return m_slots_.get() + static_cast<std::size_t>(i & (m_capacity_ - 1)) * m_stride_;
+        }
+    };
+
+    /// __profiler::stack_view
+    struct stack_view {
+        const pc_type* pcs;
+        std::size_t    size;
+        std::size_t    hash;
+    };
+
+    /// __profiler::stack_key
+    struct stack_key {
+        std::vector<pc_type> pcs;
+        std::size_t          hash;
+    };
+
+    /// __profiler::stack_hasher
+    struct stack_hasher {
+        using is_transparent = void;
+        std::size_t operator()(const stack_key& k) const noexcept { return k.hash; }
+        std::size_t operator()(const stack_view& v) const noexcept { return v.hash; }
+    };
+
+    /// __profiler::stack_equal
+    struct stack_equal {
+        using is_transparent = void;
+
+        static bool sf_equal_(const pc_type* a, std::size_t an, const pc_type* b, std::size_t bn) noexcept {
+            return an == bn && std::equal(a, a + an, b);
+        }
+
+        bool operator()(const stack_key& a, const stack_key& b) const noexcept {
+            return sf_equal_(a.pcs.data(), a.pcs.size(), b.pcs.data(), b.pcs.size());
+        }
+
+        bool operator()(const stack_key& a, const stack_view& b) const noexcept {
+            return sf_equal_(a.pcs.data(), a.pcs.size(), b.pcs, b.size);
+        }
+
+        bool operator()(const stack_view& a, const stack_key& b) const noexcept {
+            return sf_equal_(a.pcs, a.size, b.pcs.data(), b.pcs.size());
+        }
+    };
+
+    /// __profiler::state
+    struct state {
+        sampling_profiler::options m_opts_;
+        std::vector<thread_ring*>  m_rings_;
+        std::unordered_map<stack_key, std::size_t, stack_hasher, stack_equal> m_stacks_;
+        std::size_t                m_samples_ = 0;
+        std::size_t                m_dropped_ = 0;
+        bool                       m_running_ = false;
+        std::condition_variable_any m_cv_;
+        std::jthread               m_collector_;
+    };
+
+    /// __profiler::s_mutex_
+    // guards every 'state' and the ring pool; never taken by the signal handler
+    constinit std::mutex s_mutex_;
+
+    /// __profiler::s_state_
+    constinit state* s_state_ = nullptr;
+
+    /// __profiler::s_handler_installed_
+    constinit bool s_handler_installed_ = false;
+
+    /// __profiler::t_ring_
+    // note: the only thing the signal handler looks up
+    constinit thread_local thread_ring* t_ring_ = nullptr;
+
+    /// __profiler::ring_pool
+    // rings are recycled but never freed, so a stale 't_ring_' of
+    // a thread that outlived its profiler never dangles
+    std::deque<thread_ring>& ring_pool() {
+        static std::deque<thread_ring> pool;
+        return pool;
+    }
+
+    /// __profiler::on_sigprof
+    void on_sigprof(int, ::siginfo_t*, void*) {
+        const int saved_errno = errno;
+        thread_ring* ring = t_ring_;
+        if (ring != nullptr && ring->m_active_.load(std::memory_order_acquire)) {
+            const std::uint32_t head = ring->m_head_.load(std::memory_order_relaxed);
+            if (head - ring->m_tail_.load(std::memory_order_acquire) >= ring->m_capacity_) {
+                ring->m_dropped_.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                pc_type* slot = ring->slot(head);
+
+                struct data_impl {
+                    pc_type*      out;
+                    std::uint32_t size;
+                    std::uint32_t max_depth;
+                } data { slot + 1, 0, ring->m_stride_ - 1 };
+
+                // skip this handler and the signal trampoline
+                __stacktrace::unwind(2, +[](void* ptr, pc_type pc) noexcept {
+                    auto& s = *static_cast<data_impl*>(ptr);
+                    s.out[s.size++] = pc;
+                    return s.size < s.max_depth;
+                }, &data);
+
+                slot[0] = data.size;
+                ring->m_head_.store(head + 1, std::memory_order_release);
+            }
+        }
+        errno = saved_errno;
+    }
+
+    /// __profiler::install_handler
+    void install_handler() {
+        if (s_handler_installed_)
+            return;
+        // the handler stays installed for the rest of the process, a sample
+        // still pending after 'stop' must not fall back to the default action
+        // of SIGPROF, which terminates the process
+        struct ::sigaction action {};
+        action.sa_sigaction = &on_sigprof;
+        action.sa_flags     = SA_SIGINFO | SA_RESTART;
+        ::sigemptyset(&action.sa_mask);
+        if (::sigaction(SIGPROF, &action, nullptr) != 0)
+            throw sampling_profiler_error("failed to install the SIGPROF handler");
+        s_handler_installed_ = true;
+    }
+
+    /// __profiler::arm_timer
+    void arm_timer(thread_ring& ring, unsigned int frequency) noexcept {
+        const long interval_ns = 1'000'000'000L / (frequency == 0 ? 1 : frequency);
+        ::itimerspec spec {};
+        spec.it_interval.tv_sec  = interval_ns / 1'000'000'000L;
+        spec.it_interval.tv_nsec = interval_ns % 1'000'000'000L;
+        spec.it_value            = spec.it_interval;
+        ::timer_settime(ring.m_timer_, 0, &spec, nullptr);
+    }
+
+    /// __profiler::disarm_timer
+    void disarm_timer(thread_ring& ring) noexcept {
+        ::itimerspec spec {};
+        ::timer_settime(ring.m_timer_, 0, &spec, nullptr);
+    }
+
+    /// __profiler::drain_ring [ pre: s_mutex_ is held ]
+    void drain_ring(state& s, thread_ring& ring) {
+        const std::uint32_t head = ring.m_head_.load(std::memory_order_acquire);
+        std::uint32_t tail = ring.m_tail_.load(std::memory_order_relaxed);
+        for (; tail != head; ++tail) {
+            const pc_type* slot = ring.slot(tail);
+            const std::size_t depth = static_cast<std::size_t>(slot[0]);
+            stack_view view { slot + 1, depth, __stacktrace::hash_pcs(slot + 1, depth) };
+            if (auto it = s.m_stacks_.find(view); it != s.m_stacks_.end())
+                ++it->second;
+            else
+                s.m_stacks_.emplace(stack_key { std::vector<pc_type>(view.pcs, view.pcs + depth), view.hash }, 1);
+            ++s.m_samples_;
+        }
+        ring.m_tail_.store(tail, std::memory_order_release);
+        s.m_dropped_ += ring.m_dropped_.exchange(0, std::memory_order_relaxed);
+    }
+
+    /// __profiler::drain_all [ pre: s_mutex_ is held ]
+    void drain_all(state& s) {
+        for (thread_ring* ring : s.m_rings_)
+            drain_ring(s, *ring);
+    }
+
+    /// __profiler::owns_current_ring [ pre: s_mutex_ is held ]
+    bool owns_current_ring(state& s) noexcept {
+        return t_ring_ != nullptr && t_ring_->m_owner_ == &s && t_ring_->m_tid_ == ::gettid();
+    }
+
+    /// __profiler::release_ring [ pre: s_mutex_ is held ]
+    void release_ring(thread_ring& ring) noexcept {
+        ring.m_active_.store(false, std::memory_order_release);
+        if (ring.m_has_timer_) {
+            ::timer_delete(ring.m_timer_);
+            ring.m_has_timer_ = false;
+        }
+        ring.m_owner_ = nullptr;
+        ring.m_tid_   = 0;
+    }
+
+    /// __profiler::unregister_current [ pre: s_mutex_ is held ]
+    void unregister_current(state& s) noexcept {
+        if (!owns_current_ring(s)) {
+            t_ring_ = nullptr;
+            return;
+        }
+        thread_ring* ring = t_ring_;
+        ring->m_active_.store(false, std::memory_order_release);
+        try {
+            drain_ring(s, *ring);
+        } catch (...) {}
+        release_ring(*ring);
+        std::erase(s.m_rings_, ring);
+        t_ring_ = nullptr;
+    }
+
+    /// __profiler::thread_guard
+    // unregisters the thread from the live profiler on thread exit
+    struct thread_guard {
+        bool m_armed_ = false;
+
+        ~thread_guard() {
+            if (!m_armed_)
+                return;
+            std::lock_guard guard (s_mutex_);
+            if (s_state_ != nullptr)
+                unregister_current(*s_state_);
+            t_ring_ = nullptr;
+        }
+    };
+
+    /// __profiler::t_guard_
+    thread_local thread_guard t_guard_;
+
+    /// __profiler::register_current [ pre: s_mutex_ is held ]
+    void register_current(state& s) {
+        if (owns_current_ring(s))
+            return;
+
+        const std::uint32_t capacity = std::bit_ceil(static_cast<std::uint32_t>(
+            s.m_opts_.ring_capacity == 0 ? 1 : s.m_opts_.ring_capacity
+        ));
+        const std::uint32_t stride = 1u + (s.m_opts_.max_depth == 0 ? 1u : s.m_opts_.max_depth);
+
+        thread_ring* ring = nullptr;
+        for (thread_ring& r : ring_pool()) {
+            if (r.m_owner_ == nullptr) {
+                ring = &r;
+                break;
+            }
+        }
+        if (ring == nullptr)
+            ring = &ring_pool().emplace_back();
+
+        if (ring->m_capacity_ * ring->m_stride_ < capacity * stride)
+            ring->m_slots_ = std::make_unique<pc_type[]>(static_cast<std::size_t>(capacity) * stride);
+        ring->m_capacity_ = capacity;
+        ring->m_stride_   = stride;
+        ring->m_head_.store(0, std::memory_order_relaxed);
+        ring->m_tail_.store(0, std::memory_order_relaxed);
+        ring->m_dropped_.store(0, std::memory_order_relaxed);
+        ring->m_tid_ = ::gettid();
+
+        ::sigevent event {};
+        event.sigev_notify           = SIGEV_THREAD_ID;
+        event.sigev_signo            = SIGPROF;
+        event.sigev_notify_thread_id = ring->m_tid_;
+        if (::timer_create(CLOCK_THREAD_CPUTIME_ID, &event, &ring->m_timer_) != 0) {
+            ring->m_tid_ = 0;
+            throw sampling_profiler_error("failed to create the sampling timer of the thread");
+        }
+        ring->m_has_timer_ = true;
+        ring->m_owner_     = &s;
+
+        s.m_rings_.push_back(ring);
+        t_guard_.m_armed_ = true;
+        t_ring_ = ring;
+
+        if (s.m_running_) {
+            ring->m_active_.store(true, std::memory_order_release);
+            arm_timer(*ring, s.m_opts_.frequency);
+        }
+    }
+
+    /// __profiler::frame_name
+    std::string frame_name(pc_type pc) {
+        if (std::string name = __stacktrace::make_entry(pc).function_name(); !name.empty())
+            return name;
+        return gold::format("{:#x}", pc);
+    }
+
+    /// __profiler::name_cache
+    // symbolizes each distinct pc once per report
+    struct name_cache {
+        std::unordered_map<pc_type, std::string> m_names_;
+
+        const std::string& operator()(pc_type pc) {
+            if (auto it = m_names_.find(pc); it != m_names_.end())
+                return it->second;
+            return m_names_.emplace(pc, frame_name(pc)).first->second;
+        }
+    };
+
+    /// __profiler::snapshot
+    std::vector<std::pair<std::vector<pc_type>, std::size_t>> snapshot(state& s) {
+        std::lock_guard guard (s_mutex_);
+        drain_all(s);
+        std::vector<std::pair<std::vector<pc_type>, std::size_t>> result;
+        result.reserve(s.m_stacks_.size());
+        for (const auto& [key, count] : s.m_stacks_)
+            result.emplace_back(key.pcs, count);
+        return result;
+    }
+
+} // namespace gold::__profiler
+
+namespace gold {
+
+    /// sampling_profiler ctors
+    sampling_profiler::sampling_profiler()
+    : sampling_profiler(options{}) {}
+
+    sampling_profiler::sampling_profiler(const options& opts)
+    : m_state_(std::make_unique<__profiler::state>()) {
+        m_state_->m_opts_ = opts;
+        std::lock_guard guard (__profiler::s_mutex_);
+        if (__profiler::s_state_ != nullptr)
+            throw sampling_profiler_error("only one sampling_profiler can exist at a time");
+        __profiler::s_state_ = m_state_.get();
+    }
+
+    /// sampling_profiler dtor
+    sampling_profiler::~sampling_profiler() {
+        this->stop();
+        std::lock_guard guard (__profiler::s_mutex_);
+        for (__profiler::thread_ring* ring : m_state_->m_rings_)
+            __profiler::release_ring(*ring);
+        m_state_->m_rings_.clear();
+        if (__profiler::owns_current_ring(*m_state_))
+            __profiler::t_ring_ = nullptr;
+        __profiler::s_state_ = nullptr;
+    }
+
+    /// register_thread
+    void sampling_profiler::register_thread() {
+        std::lock_guard guard (__profiler::s_mutex_);
+        __profiler::register_current(*m_state_);
+    }
+
+    /// unregister_thread
+    void sampling_profiler::unregister_thread() noexcept {
+        std::lock_guard guard (__profiler::s_mutex_);
+        __profiler::unregister_current(*m_state_);
+    }
+
+    /// start
+    void sampling_profiler::start() {
+        std::lock_guard guard (__profiler::s_mutex_);
+        if (m_state_->m_running_)
+            return;
+
+        __profiler::install_handler();
+        __profiler::register_current(*m_state_);
+
+        m_state_->m_running_ = true;
+        for (__profiler::thread_ring* ring : m_state_->m_rings_) {
+            ring->m_active_.store(true, std::memory_order_release);
+            __profiler::arm_timer(*ring, m_state_->m_opts_.frequency);
+        }
+
+        m_state_->m_collector_ = std::jthread([s = m_state_.get()](std::stop_token token) {
+            std::unique_lock lock (__profiler::s_mutex_);
+            while (!token.stop_requested()) {
+                s->m_cv_.wait_for(lock, token, s->m_opts_.drain_period, [] { return false; });
+                __profiler::drain_all(*s);
+            }
+        });
+    }
+
+    /// stop
+    void sampling_profiler::stop() noexcept {
+        {
+            std::lock_guard guard (__profiler::s_mutex_);
+            if (!m_state_->m_running_)
+                return;
+            m_state_->m_running_ = false;
+            for (__profiler::thread_ring* ring : m_state_->m_rings_) {
+                __profiler::disarm_timer(*ring);
+                ring->m_active_.store(false, std::memory_order_release);
+            }
+        }
+
+        m_state_->m_collector_.request_stop();
+        if (m_state_->m_collector_.joinable())
+            m_state_->m_collector_.join();
+
+        std::lock_guard guard (__profiler::s_mutex_);
+        try {
+            __profiler::drain_all(*m_state_);
+        } catch (...) {}
+    }
+
+    /// is_running
+    bool sampling_profiler::is_running() const noexcept {
+        std::lock_guard guard (__profiler::s_mutex_);
+        return m_state_->m_running_;
+    }
+
+    /// reset
+    void sampling_profiler::reset() noexcept {
+        std::lock_guard guard (__profiler::s_mutex_);
+        for (__profiler::thread_ring* ring : m_state_->m_rings_) {
+            ring->m_tail_.store(ring->m_head_.load(std::memory_order_acquire), std::memory_order_release);
+            ring->m_dropped_.store(0, std::memory_order_relaxed);
+        }
+        m_state_->m_stacks_.clear();
+        m_state_->m_samples_ = 0;
+        m_state_->m_dropped_ = 0;
+    }
+
+    /// sample_count
+    std::size_t sampling_profiler::sample_count() const noexcept {
+        std::lock_guard guard (__profiler::s_mutex_);
+        return m_state_->m_samples_;
+    }
+
+    /// dropped_count
+    std::size_t sampling_profiler::dropped_count() const noexcept {
+        std::lock_guard guard (__profiler::s_mutex_);
+        return m_state_->m_dropped_;
+    }
+
+    /// folded
+    std::string sampling_profiler::folded() const {
+        auto stacks = __profiler::snapshot(*m_state_);
+        __profiler::name_cache names;
+        std::string result;
+        auto out = std::back_inserter(result);
+        for (const auto& [pcs, count] : stacks) {
+            if (pcs.empty())
+                continue;
+            // captured leaf first, folded stacks are written root first
+            for (auto it = pcs.rbegin(); it != pcs.rend(); ++it) {
+                if (it != pcs.rbegin())
+                    result.push_back(';');
+                result += names(*it);
+            }
+            gold::format_to(out, " {}\n", count);
+        }
+        return result;
+    }
+
+    /// top
+    std::vector<sampling_profiler::function_stat> sampling_profiler::top(std::size_t n) const {
+        auto stacks = __profiler::snapshot(*m_state_);
+        __profiler::name_cache names;
+        std::unordered_map<std::string_view, function_stat> stats;
+        std::unordered_set<std::string_view> seen;
+
+        for (const auto& [pcs, count] : stacks) {
+            if (pcs.empty())
+                continue;
+            const std::string& leaf = names(pcs.front());
+            stats[leaf].self += count;
+            seen.clear();
+            for (__profiler::pc_type pc : pcs) {
+                const std::string& name = names(pc);
+                // recursive frames only count once towards 'total'
+                if (seen.insert(name).second)
+                    stats[name].total += count;
+            }
+        }
+
+        std::vector<function_stat> result;
+        result.reserve(stats.size());
+        for (auto& [name, stat] : stats) {
+            stat.function = name;
+            result.push_back(std::move(stat));
+        }
+
+        auto by_self = [](const function_stat& a, const function_stat& b) {
+            return a.self != b.self ? a.self > b.self : a.total > b.total;
+        };
+        if (n < result.size()) {
+            std::partial_sort(result.begin(), result.begin() + n, result.end(), by_self);
+            result.resize(n);
+        } else {
+            std::sort(result.begin(), result.end(), by_self);
+        }
+        return result;
+    }
+
+    /// report
+    std::string sampling_profiler::report(std::size_t n) const {
+        const std::vector<function_stat> stats = this->top(n);
+        const std::size_t samples = this->sample_count();
+        const double scale = samples == 0 ? 0.0 : 100.0 / static_cast<double>(samples);
+
+        std::string result;
+        auto out = std::back_inserter(result);
+        gold::format_to(out, "{:>10} {:>8} {:>10} {:>8}  {}\n", "self", "self%", "total", "total%", "function");
+        for (const function_stat& stat : stats) {
+            gold::format_to(out, "{:>10} {:>7.2f}% {:>10} {:>7.2f}%  {}\n",
+                            stat.self, static_cast<double>(stat.self) * scale,
+                            stat.total, static_cast<double>(stat.total) * scale,
+                            stat.function);
+        }
+        gold::format_to(out, "{} samples, {} dropped\n", samples, this->dropped_count());
+        return result;
+    }
+
+} // namespace gold
+
+#else
+
+namespace gold::__profiler {
+
+    /// __profiler::state [ never created ]
+    struct state {};
+
+} // namespace gold::__profiler
+
+namespace gold {
+
+    // per-thread cpu timers and 'SIGPROF' are linux-only
+
+    sampling_profiler::sampling_profiler()
+    : sampling_profiler(options{}) {}
+
+    sampling_profiler::sampling_profiler(const options&) {
+        throw sampling_profiler_error("sampling_profiler: not supported on this platform");
+    }
+
+    sampling_profiler::~sampling_profiler() = default;
+
+    void sampling_profiler::register_thread() {}
+
+    void sampling_profiler::unregister_thread() noexcept {}
+
+    void sampling_profiler::start() {}
+
+    void sampling_profiler::stop() noexcept {}
+
+    bool sampling_profiler::is_running() const noexcept { return false; }
+
+    void sampling_profiler::reset() noexcept {}
+
+    std::size_t sampling_profiler::sample_count() const noexcept { return 0; }
+
+    std::size_t sampling_profiler::dropped_count() const noexcept { return 0; }
+
+    std::string sampling_profiler::folded() const { return {}; }
+
+    std::vector<sampling_profiler::function_stat> sampling_profiler::top(std::size_t) const { return {}; }
+
+    std::string sampling_profiler::report(std::size_t) const { return {}; }
+
+} // namespace gold
+
+#endif // __linux__
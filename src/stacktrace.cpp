@@ -1,9 +1,14 @@
-#include <sstream>
+#include <iterator>
+#include <ostream>
 #include <cstdint>
 #include <gold/stacktrace>
 #include <gold/demangling>
-#include <gold/bits/algo/min_max.hpp>
 #include <dlfcn.h>
+#include <unwind.h>
+
+#if defined(__linux__)
+#include <errno.h> // program_invocation_name
+#endif
 
 /// requires additional linking '-lstdc++_libbacktrace -ldl'
 
@@ -16,12 +21,6 @@ __glibcxx_backtrace_create_state(const char*, int,
 				 void(*)(void*, const char*, int),
 				 void*);
 
-int
-__glibcxx_backtrace_simple(__glibcxx_backtrace_state*, int,
-			   int (*) (void*, std::uintptr_t),
-			   void(*)(void*, const char*, int),
-			   void*);
-
 int
 __glibcxx_backtrace_pcinfo(__glibcxx_backtrace_state*, std::uintptr_t,
 			   int (*)(void*, std::uintptr_t,
@@ -48,38 +47,48 @@ namespace gold::__stacktrace {
         static ::__glibcxx_backtrace_state* get_backtrace_state() {
             static ::__glibcxx_backtrace_state* result = nullptr;
             if (!result)
+#if defined(__linux__)
+                result = ::__glibcxx_backtrace_create_state(::program_invocation_name, 1, &error_handler, nullptr);
+#else
                 result = ::__glibcxx_backtrace_create_state(__argv[0], 1, &error_handler, nullptr);
+#endif
             return result;
         }
 
+        /// __stacktrace::impl::symbol_names
+        // the same few symbols get printed over and over
+        static gold::demangle_cache& symbol_names() {
+            static gold::demangle_cache s_names_ (2048);
+            return s_names_;
+        }
+
         /// __stacktrace::impl::s_backtrace_style_
         inline static constinit gold::stacktrace_style s_backtrace_style_ = gold::stacktrace_style::by_default;
 
-        /// __stacktrace::impl::backtrace_capture
-        static void backtrace_capture(gold::stacktrace* trace_ptr,
-                                      std::size_t skip,
-                                      std::size_t max_depth) {
-
-            trace_ptr->m_entries_.reserve(gold::__algo::min(static_cast<int>(max_depth), 64));
-
-            struct data_impl {
-                gold::stacktrace* trace_ptr;
-                std::size_t max_depth;
-            } data { trace_ptr, max_depth };
-
-            auto state = get_backtrace_state();
-            auto cb = +[](void* data, std::uintptr_t pc) {
-                auto& s = *static_cast<data_impl*>(data);
-                gold::stacktrace_entry f;
-                f.m_pc_ = pc;
-                if (f && s.trace_ptr->m_entries_.size() < s.max_depth) {
-                    s.trace_ptr->m_entries_.push_back(f);
-                    return 0;
-                }
-                return 1;
-            };
-
-            ::__glibcxx_backtrace_simple(state, skip + 1, cb, &error_handler, &data); // plus 1 for 1 skip
+        /// __stacktrace::impl::unwind_state
+        struct unwind_state {
+            std::size_t     skip;
+            unwind_callback callback;
+            void*           data;
+        };
+
+        /// __stacktrace::impl::unwind_trace
+        // note: invoked by '_Unwind_Backtrace' for each frame, must stay async-signal-safe
+        static ::_Unwind_Reason_Code unwind_trace(::_Unwind_Context* ctx, void* ptr) {
+            auto& s = *static_cast<unwind_state*>(ptr);
+            int ip_before_insn = 0;
+            std::uintptr_t pc = ::_Unwind_GetIPInfo(ctx, &ip_before_insn);
+            if (pc == 0)
+                return ::_URC_END_OF_STACK;
+            if (s.skip != 0) {
+                --s.skip;
+                return ::_URC_NO_REASON;
+            }
+            // point into the call instruction rather than the return address,
+            // the same adjustment libbacktrace applies before symbolizing
+            if (!ip_before_insn)
+                --pc;
+            return s.callback(s.data, pc) ? ::_URC_NO_REASON : ::_URC_END_OF_STACK;
         }
 
         /// backtrace_get_info
@@ -103,10 +112,9 @@ namespace gold::__stacktrace {
             auto pc_cb = +[](void* ptr, std::uintptr_t, const char* filename, int lineno, const char* func) -> int {
                 auto& info = *static_cast<trace_info_t*>(ptr);
                 if (info.m_func_) {
+                    info.m_func_->clear();
                     if (func)
-                        *info.m_func_ = gold::demangle(func);
-                    else
-                        *info.m_func_ = "";
+                        symbol_names().demangle_to(func, std::back_inserter(*info.m_func_));
                 }
                 if (info.m_file_) {
                     if (filename)
@@ -122,9 +130,10 @@ namespace gold::__stacktrace {
             auto sym_cb = +[](void* data, std::uintptr_t, const char* symname,
                               std::uintptr_t, std::uintptr_t) {
                 auto& s = *static_cast<std::string*>(data);
-                if (symname)
-                    s = gold::demangle(symname);
-                else
+                if (symname) {
+                    s.clear();
+                    symbol_names().demangle_to(symname, std::back_inserter(s));
+                } else
                     s = "???";
             };
 
@@ -185,73 +194,42 @@ namespace gold {
         return static_cast<std::uint32_t>(result);
     }
 
-    stacktrace_style stacktrace::style() noexcept {
-        return __stacktrace::impl::s_backtrace_style_;
+    /// __stacktrace::unwind
+    void __stacktrace::unwind(std::size_t skip, unwind_callback callback, void* data) noexcept {
+        __stacktrace::impl::unwind_state state { skip + 1, callback, data }; // plus 1 for this frame
+        ::_Unwind_Backtrace(&__stacktrace::impl::unwind_trace, &state);
     }
 
-    void stacktrace::style(stacktrace_style style) noexcept {
-        __stacktrace::impl::s_backtrace_style_ = style;
-    }
-
-    stacktrace stacktrace::current() noexcept {
-        return current(1, size_type(-1));
+    /// __stacktrace::get_style
+    stacktrace_style __stacktrace::get_style() noexcept {
+        return __stacktrace::impl::s_backtrace_style_;
     }
 
-    stacktrace stacktrace::current(size_type skip) noexcept {
-        return current(skip + 1, size_type(-1));
+    /// __stacktrace::set_style
+    void __stacktrace::set_style(stacktrace_style style) noexcept {
+        __stacktrace::impl::s_backtrace_style_ = style;
     }
 
-    stacktrace stacktrace::current(size_type skip, size_type max_depth) noexcept {
-        // [[precondition: skip <= (size_type(-1) - max_depth)]]
-        stacktrace result;
-        __stacktrace::impl::backtrace_capture(&result, skip + 1, max_depth);
-        return result;
+    /// __stacktrace::resolve
+    void __stacktrace::resolve(native_handle_type pc, frame_info& info, stacktrace_style style) {
+        info.function.clear();
+        info.file.clear();
+        info.line   = 0;
+        info.offset = 0;
+        if (style == stacktrace_style::by_source)
+            __stacktrace::impl::backtrace_get_info(pc, &info.function, nullptr, &info.file, &info.line, nullptr);
+        else
+            __stacktrace::impl::backtrace_get_info(pc, &info.function, &info.file, nullptr, nullptr, &info.offset);
     }
 
     /// operator<<
     std::ostream& operator<<(std::ostream& os, const stacktrace_entry& entry) {
-        std::string func, file;
-        std::ios_base::fmtflags saved_flags (os.flags());
-        os.width(4);
-        if (__stacktrace::impl::s_backtrace_style_ == stacktrace_style::by_source) {
-            int line;
-            __stacktrace::impl::backtrace_get_info(entry.m_pc_, &func, nullptr, &file, &line, nullptr);
-                os << func << " at "
-                   << file << ':'
-                   << line;
-        } else {
-            std::ptrdiff_t offset;
-            __stacktrace::impl::backtrace_get_info(entry.m_pc_, &func, &file, nullptr, nullptr, &offset);
-            os.setf(os.showbase);
-            os.setf(os.hex);
-            os << reinterpret_cast<void*>(entry.m_pc_)
-               << " in <" << func << '+' << offset << "> at "
-               << file;
-        }
-        os.flags(saved_flags);
-        return os;
-    }
-
-    std::ostream& operator<<(std::ostream& os, const stacktrace& st) {
-        for (stacktrace::size_type i = 0; i < st.size(); ++i) {
-            os.width(4);
-            os << '#' << i << ' ' << st[i] << '\n';
-        }
-        return os;
+        return os << gold::to_string(entry);
     }
 
     /// to_string<stacktrace_entry>
     std::string to_string(const stacktrace_entry& entry) {
-        std::ostringstream oss;
-        oss << entry;
-        return std::move(oss).str();
-    }
-
-    /// to_string<stacktrace>
-    std::string to_string(const stacktrace& st) {
-        std::ostringstream oss;
-        oss << st;
-        return std::move(oss).str();
+        return gold::format("{}", entry);
     }
 
 } // namespace gold
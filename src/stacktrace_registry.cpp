@@ -0,0 +1,192 @@
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <gold/stacktrace_registry>
+
+namespace gold::__stacktrace {
+
+    /// __stacktrace::registry_record
+    struct registry_record {
+        std::vector<stacktrace_entry>   m_entries_;
+        std::size_t                     m_hash_ = 0;
+        std::atomic<std::size_t>        m_count_ { 0 };
+        std::atomic<std::int64_t>       m_first_seen_ { 0 };
+        std::atomic<std::int64_t>       m_last_seen_ { 0 };
+        std::once_flag                  m_described_;
+        std::string                     m_description_;
+
+        bool same_as(const stacktrace_entry* entries, std::size_t n) const noexcept {
+            return m_entries_.size() == n && std::equal(entries, entries + n, m_entries_.begin());
+        }
+    };
+
+    /// __stacktrace::registry_shard
+    struct alignas(64) registry_shard {
+        std::mutex                                         m_mtx_;
+        std::unordered_multimap<std::size_t, std::uint32_t> m_ids_; // hash -> id
+    };
+
+    /// __stacktrace::registry_state
+    // records live in fixed-size segments that are never moved, which lets
+    // lookups by id go without a lock once the id has been published
+    struct registry_state {
+        static constexpr std::size_t s_shard_count_    = 16;
+        static constexpr std::size_t s_segment_bits_   = 10;
+        static constexpr std::size_t s_segment_size_   = std::size_t(1) << s_segment_bits_;
+        static constexpr std::size_t s_max_segments_   = 4096;
+
+        registry_shard                               m_shards_[s_shard_count_];
+        std::atomic<registry_record*>                m_segments_[s_max_segments_] {};
+        std::mutex                                   m_append_mtx_;
+        std::atomic<std::uint32_t>                   m_size_ { 0 };
+
+        ~registry_state() {
+            for (auto& segment : m_segments_)
+                delete[] segment.load(std::memory_order_relaxed);
+        }
+
+        registry_record& record(std::uint32_t id) const noexcept {
+            registry_record* segment = m_segments_[id >> s_segment_bits_].load(std::memory_order_acquire);
+            return segment[id & (s_segment_size_ - 1)];
+        }
+
+        registry_record* find(const registry_shard& shard, std::size_t hash,
+                              const stacktrace_entry* entries, std::size_t n,
+                              std::uint32_t& id) const noexcept {
+            auto [first, last] = shard.m_ids_.equal_range(hash);
+            for (; first != last; ++first) {
+                registry_record& rec = record(first->second);
+                if (rec.same_as(entries, n)) {
+                    id = first->second;
+                    return &rec;
+                }
+            }
+            return nullptr;
+        }
+
+        // pre: the shard 'hash' belongs to is locked
+        // the record is filled in before 'm_size_' publishes it to readers
+        std::uint32_t append(std::size_t hash, const stacktrace_entry* entries, std::size_t n, std::int64_t first_seen) {
+            std::lock_guard guard (m_append_mtx_);
+            const std::uint32_t id = m_size_.load(std::memory_order_relaxed);
+            const std::size_t segment_index = id >> s_segment_bits_;
+            if (segment_index >= s_max_segments_)
+                throw std::length_error("stacktrace_registry: too many unique stack traces");
+            registry_record* segment = m_segments_[segment_index].load(std::memory_order_relaxed);
+            if (segment == nullptr) {
+                segment = new registry_record[s_segment_size_];
+                m_segments_[segment_index].store(segment, std::memory_order_release);
+            }
+            registry_record& rec = segment[id & (s_segment_size_ - 1)];
+            rec.m_entries_.assign(entries, entries + n);
+            rec.m_hash_ = hash;
+            rec.m_first_seen_.store(first_seen, std::memory_order_relaxed);
+            m_size_.store(id + 1, std::memory_order_release);
+            return id;
+        }
+    };
+
+    /// __stacktrace::registry_now
+    inline std::int64_t registry_now() noexcept {
+        return stacktrace_registry::clock_type::now().time_since_epoch().count();
+    }
+
+    /// __stacktrace::registry_time_point
+    inline stacktrace_registry::time_point registry_time_point(std::int64_t ticks) noexcept {
+        return stacktrace_registry::time_point(stacktrace_registry::clock_type::duration(ticks));
+    }
+
+} // namespace gold::__stacktrace
+
+namespace gold {
+
+    /// stacktrace_registry ctors
+    stacktrace_registry::stacktrace_registry()
+    : m_state_(std::make_unique<__stacktrace::registry_state>()) {}
+
+    /// stacktrace_registry dtor
+    stacktrace_registry::~stacktrace_registry() = default;
+
+    /// mf_intern_
+    auto stacktrace_registry::mf_intern_(const stacktrace_entry* entries, size_type n) -> id_type {
+        auto& state = *m_state_;
+        const std::size_t hash = __stacktrace::hash_entries(entries, n);
+        const std::int64_t now = __stacktrace::registry_now();
+        auto& shard = state.m_shards_[hash % __stacktrace::registry_state::s_shard_count_];
+
+        std::uint32_t id = 0;
+        __stacktrace::registry_record* rec = nullptr;
+        {
+            std::lock_guard guard (shard.m_mtx_);
+            rec = state.find(shard, hash, entries, n, id);
+            if (rec == nullptr) {
+                id  = state.append(hash, entries, n, now);
+                rec = &state.record(id);
+                shard.m_ids_.emplace(hash, id);
+            }
+        }
+
+        rec->m_count_.fetch_add(1, std::memory_order_relaxed);
+        std::int64_t last = rec->m_last_seen_.load(std::memory_order_relaxed);
+        while (last < now && !rec->m_last_seen_.compare_exchange_weak(last, now, std::memory_order_relaxed))
+            ;
+        return id;
+    }
+
+    /// size
+    auto stacktrace_registry::size() const noexcept -> size_type {
+        return m_state_->m_size_.load(std::memory_order_acquire);
+    }
+
+    /// contains
+    bool stacktrace_registry::contains(id_type id) const noexcept {
+        return id < m_state_->m_size_.load(std::memory_order_acquire);
+    }
+
+    /// info
+    auto stacktrace_registry::info(id_type id) const -> record_info {
+        if (!this->contains(id))
+            throw std::out_of_range("stacktrace_registry::info: unknown id");
+        const auto& rec = m_state_->record(id);
+        return {
+            .id         = id,
+            .hash       = rec.m_hash_,
+            .count      = rec.m_count_.load(std::memory_order_relaxed),
+            .first_seen = __stacktrace::registry_time_point(rec.m_first_seen_.load(std::memory_order_relaxed)),
+            .last_seen  = __stacktrace::registry_time_point(rec.m_last_seen_.load(std::memory_order_relaxed))
+        };
+    }
+
+    /// trace
+    stacktrace stacktrace_registry::trace(id_type id) const {
+        if (!this->contains(id))
+            throw std::out_of_range("stacktrace_registry::trace: unknown id");
+        const auto& rec = m_state_->record(id);
+        return __stacktrace::make_stacktrace(rec.m_entries_.data(), rec.m_entries_.size(),
+                                             std::allocator<stacktrace_entry>());
+    }
+
+    /// description
+    const std::string& stacktrace_registry::description(id_type id) const {
+        if (!this->contains(id))
+            throw std::out_of_range("stacktrace_registry::description: unknown id");
+        auto& rec = m_state_->record(id);
+        std::call_once(rec.m_described_, [&] {
+            rec.m_description_ = gold::to_string(this->trace(id));
+        });
+        return rec.m_description_;
+    }
+
+    /// records
+    auto stacktrace_registry::records() const -> std::vector<record_info> {
+        const id_type n = static_cast<id_type>(this->size());
+        std::vector<record_info> result;
+        result.reserve(n);
+        for (id_type id = 0; id < n; ++id)
+            result.push_back(this->info(id));
+        return result;
+    }
+
+} // namespace gold
@@ -0,0 +1,275 @@
+#include <algorithm>
+#include <gold/thread_pool>
+
+namespace gold::__coro {
+
+    /// __coro::work_deque
+    // Chase-Lev work-stealing deque of coroutine handles: the owning worker
+    // pushes and pops at the bottom, other workers steal from the top. the
+    // ring only grows; replaced rings stay alive until the deque dies since
+    // a thief may still be reading from one
+    class work_deque {
+      private:
+        struct ring {
+            std::int64_t                            m_mask_;
+            std::unique_ptr<std::atomic<void*>[]>   m_slots_;
+
+            explicit ring(std::int64_t capacity)
+            : m_mask_(capacity - 1), m_slots_(new std::atomic<void*>[capacity]) {}
+
+            std::int64_t capacity() const noexcept { return m_mask_ + 1; }
+
+            void put(std::int64_t i, void* p) noexcept {
+                m_slots_[i & m_mask_].store(p, std::memory_order_relaxed);
+            }
+
+            void* get(std::int64_t i) const noexcept {
+                return m_slots_[i & m_mask_].load(std::memory_order_relaxed);
+            }
+        };
+
+        alignas(64) std::atomic<std::int64_t> m_top_    { 0 };
+        alignas(64) std::atomic<std::int64_t> m_bottom_ { 0 };
+        alignas(64) std::atomic<ring*>        m_ring_;
+        std::vector<std::unique_ptr<ring>>    m_rings_; // owner only
+
+        ring* mf_grow_(ring* old, std::int64_t top, std::int64_t bottom) {
+            auto next = std::make_unique<ring>(old->capacity() * 2);
+            for (std::int64_t i = top; i < bottom; ++i)
+                next->put(i, old->get(i));
+            ring* result = next.get();
+            m_rings_.push_back(std::move(next));
+            m_ring_.store(result, std::memory_order_release);
+            return result;
+        }
+
+      public:
+        explicit work_deque(std::int64_t capacity = 256) {
+            m_rings_.push_back(std::make_unique<ring>(capacity));
+            m_ring_.store(m_rings_.back().get(), std::memory_order_relaxed);
+        }
+
+        /// push [ owner only ]
+        void push(std::coroutine_handle<> coro) {
+            const std::int64_t bottom = m_bottom_.load(std::memory_order_relaxed);
+            const std::int64_t top    = m_top_.load(std::memory_order_acquire);
+            ring* r = m_ring_.load(std::memory_order_relaxed);
+            if (bottom - top > r->capacity() - 1)
+                r = this->mf_grow_(r, top, bottom);
+            r->put(bottom, coro.address());
+            m_bottom_.store(bottom + 1, std::memory_order_release);
+        }
+
+        /// pop [ owner only, most recently pushed first ]
+        std::coroutine_handle<> pop() noexcept {
+            const std::int64_t bottom = m_bottom_.load(std::memory_order_relaxed) - 1;
+            ring* r = m_ring_.load(std::memory_order_relaxed);
+            m_bottom_.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            std::int64_t top = m_top_.load(std::memory_order_relaxed);
+
+            if (top > bottom) {
+                // empty
+                m_bottom_.store(bottom + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            void* result = r->get(bottom);
+            if (top == bottom) {
+                // last element: race the thieves for it
+                if (!m_top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                    result = nullptr;
+                m_bottom_.store(bottom + 1, std::memory_order_relaxed);
+            }
+            return std::coroutine_handle<>::from_address(result);
+        }
+
+        /// steal [ any thread, oldest first ]
+        std::coroutine_handle<> steal() noexcept {
+            std::int64_t top = m_top_.load(std::memory_order_acquire);
+            for (;;) {
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                const std::int64_t bottom = m_bottom_.load(std::memory_order_acquire);
+                if (top >= bottom)
+                    return nullptr;
+                void* result = m_ring_.load(std::memory_order_acquire)->get(top);
+                if (m_top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                    return std::coroutine_handle<>::from_address(result);
+                // lost to the owner or another thief; 'top' was reloaded
+            }
+        }
+    };
+
+    /// __coro::pool_worker
+    struct pool_worker {
+        work_deque    m_deque_;
+        thread_pool*  m_pool_;
+        std::size_t   m_index_;
+        std::uint64_t m_rng_;
+
+        pool_worker(thread_pool& pool, std::size_t index) noexcept
+        : m_pool_(&pool), m_index_(index), m_rng_(0x9e3779b97f4a7c15ull * (index + 1)) {}
+
+        /// next victim to steal from [ xorshift ]
+        std::size_t victim(std::size_t count) noexcept {
+            m_rng_ ^= m_rng_ << 13;
+            m_rng_ ^= m_rng_ >> 7;
+            m_rng_ ^= m_rng_ << 17;
+            return static_cast<std::size_t>(m_rng_ % count);
+        }
+    };
+
+    /// __coro::t_worker_ [ the worker running on this thread, if any ]
+    thread_local pool_worker* t_worker_ = nullptr;
+
+} // namespace gold::__coro
+
+namespace gold {
+
+    /// thread_pool ctors
+    thread_pool::thread_pool(std::size_t thread_count) {
+        if (thread_count == 0)
+            thread_count = std::max(1u, std::thread::hardware_concurrency());
+
+        m_workers_.reserve(thread_count);
+        for (std::size_t i = 0; i < thread_count; ++i)
+            m_workers_.push_back(std::make_unique<__coro::pool_worker>(*this, i));
+
+        // every deque exists before the first worker may try to steal
+        m_threads_.reserve(thread_count);
+        for (auto& worker : m_workers_)
+            m_threads_.emplace_back([this, w = worker.get()] { this->mf_run_(*w); });
+    }
+
+    /// thread_pool dtor
+    thread_pool::~thread_pool() {
+        {
+            std::unique_lock lock (m_spawn_mtx_);
+            m_spawn_cv_.wait(lock, [this] { return m_spawned_.load(std::memory_order_acquire) == 0; });
+        }
+        m_stopping_.store(true, std::memory_order_seq_cst);
+        m_wake_epoch_.fetch_add(1, std::memory_order_seq_cst);
+        m_wake_epoch_.notify_all();
+        m_threads_.clear(); // joins
+    }
+
+    /// mf_run_
+    void thread_pool::mf_run_(__coro::pool_worker& self) {
+        __coro::t_worker_ = &self;
+        for (;;) {
+            if (auto coro = this->mf_find_work_(self)) {
+                coro.resume();
+                continue;
+            }
+
+            // announce the intent to sleep, then look once more: whoever
+            // queues work after this point sees 'm_sleeping_' and bumps
+            // the epoch, which makes the wait below return immediately
+            const std::uint32_t epoch = m_wake_epoch_.load(std::memory_order_acquire);
+            m_sleeping_.fetch_add(1, std::memory_order_seq_cst);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            if (auto coro = this->mf_find_work_(self)) {
+                m_sleeping_.fetch_sub(1, std::memory_order_relaxed);
+                coro.resume();
+                continue;
+            }
+            if (m_stopping_.load(std::memory_order_acquire)) {
+                m_sleeping_.fetch_sub(1, std::memory_order_relaxed);
+                break;
+            }
+            m_wake_epoch_.wait(epoch, std::memory_order_acquire);
+            m_sleeping_.fetch_sub(1, std::memory_order_relaxed);
+        }
+        __coro::t_worker_ = nullptr;
+    }
+
+    /// mf_find_work_ [ own deque, then the injection queue, then a victim ]
+    std::coroutine_handle<> thread_pool::mf_find_work_(__coro::pool_worker& self) {
+        if (auto coro = self.m_deque_.pop())
+            return coro;
+        if (m_injected_count_.load(std::memory_order_relaxed) != 0)
+            if (auto coro = this->mf_take_injected_())
+                return coro;
+
+        const std::size_t count = m_workers_.size();
+        if (count > 1) {
+            const std::size_t start = self.victim(count);
+            for (std::size_t i = 0; i < count; ++i) {
+                const std::size_t victim = (start + i) % count;
+                if (victim == self.m_index_)
+                    continue;
+                if (auto coro = m_workers_[victim]->m_deque_.steal())
+                    return coro;
+            }
+        }
+        return nullptr;
+    }
+
+    /// mf_take_injected_
+    std::coroutine_handle<> thread_pool::mf_take_injected_() {
+        std::lock_guard guard (m_inject_mtx_);
+        if (m_injected_.empty())
+            return nullptr;
+        auto coro = m_injected_.front();
+        m_injected_.pop_front();
+        m_injected_count_.fetch_sub(1, std::memory_order_relaxed);
+        return coro;
+    }
+
+    /// mf_wake_one_
+    void thread_pool::mf_wake_one_() noexcept {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_sleeping_.load(std::memory_order_relaxed) != 0) {
+            m_wake_epoch_.fetch_add(1, std::memory_order_release);
+            m_wake_epoch_.notify_one();
+        }
+    }
+
+    /// enqueue
+    void thread_pool::enqueue(std::coroutine_handle<> coro) {
+        __coro::pool_worker* worker = __coro::t_worker_;
+        if (worker != nullptr && worker->m_pool_ == this) {
+            worker->m_deque_.push(coro);
+        } else {
+            std::lock_guard guard (m_inject_mtx_);
+            m_injected_.push_back(coro);
+            m_injected_count_.fetch_add(1, std::memory_order_relaxed);
+        }
+        this->mf_wake_one_();
+    }
+
+    /// mf_spawn_done_
+    // decremented and notified under the lock: once the count drops to
+    // zero, 'wait' may return and the pool be destroyed, so the mutex must
+    // not be touched after it is released
+    void thread_pool::mf_spawn_done_() noexcept {
+        std::lock_guard guard (m_spawn_mtx_);
+        if (m_spawned_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            m_spawn_cv_.notify_all();
+    }
+
+    /// mf_spawn_failed_ [ keeps the first exception ]
+    void thread_pool::mf_spawn_failed_(std::exception_ptr except) noexcept {
+        std::lock_guard guard (m_spawn_mtx_);
+        if (!m_spawn_except_)
+            m_spawn_except_ = std::move(except);
+    }
+
+    /// wait
+    void thread_pool::wait() {
+        std::unique_lock lock (m_spawn_mtx_);
+        m_spawn_cv_.wait(lock, [this] { return m_spawned_.load(std::memory_order_acquire) == 0; });
+        if (m_spawn_except_)
+            std::rethrow_exception(std::exchange(m_spawn_except_, nullptr));
+    }
+
+    /// current_worker
+    std::ptrdiff_t thread_pool::current_worker() const noexcept {
+        const __coro::pool_worker* worker = __coro::t_worker_;
+        if (worker != nullptr && worker->m_pool_ == this)
+            return static_cast<std::ptrdiff_t>(worker->m_index_);
+        return -1;
+    }
+
+} // namespace gold
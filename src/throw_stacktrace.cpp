@@ -0,0 +1,130 @@
+// records the throw site of every exception as raw program counters, keyed
+// by the address of the thrown object, by wrapping '__cxa_throw' at link
+// time; opt-in, as nothing refers to the wrappers unless the program is
+// linked with:
+//
+//     -Wl,--wrap=__cxa_throw,--wrap=__cxa_allocate_exception
+//
+// note: only throws in objects of that link are seen; one from within a
+//       shared library, the c++ runtime included, has no trace
+
+#include <cstring>
+#include <exception>
+#include <typeinfo>
+#include <cxxabi.h>
+#include <gold/stacktrace>
+
+namespace gold::__stacktrace {
+
+    /// __stacktrace::throw_trace
+    struct throw_trace {
+        static constexpr std::size_t s_max_depth_ = 64;
+
+        std::size_t         m_size_ = 0;
+        native_handle_type  m_pcs_[s_max_depth_] {};
+
+        static bool push(void* data, native_handle_type pc) noexcept {
+            auto& self = *static_cast<throw_trace*>(data);
+            self.m_pcs_[self.m_size_++] = pc;
+            return self.m_size_ < s_max_depth_;
+        }
+    };
+
+    /// __stacktrace::throw_ring
+    // the traces of the last 's_slot_count_' objects thrown by this thread,
+    // so nested and rethrown exceptions find their own trace; the oldest
+    // entry is reused once all slots are taken. being per thread, an
+    // exception handled on another thread than the one that threw it
+    // ('std::exception_ptr') has no trace
+    struct throw_ring {
+        static constexpr std::size_t s_slot_count_ = 8;
+
+        std::size_t  m_victim_ = 0;
+        void*        m_keys_[s_slot_count_] {};
+        throw_trace  m_traces_[s_slot_count_];
+
+        /// find [ 's_slot_count_' if absent ]
+        std::size_t find(const void* obj) const noexcept {
+            for (std::size_t i = 0; i < s_slot_count_; ++i)
+                if (m_keys_[i] == obj)
+                    return i;
+            return s_slot_count_;
+        }
+
+        /// acquire [ the slot to record the trace of 'obj' into ]
+        throw_trace& acquire(void* obj) noexcept {
+            std::size_t i = this->find(obj);
+            if (i == s_slot_count_) {
+                i = m_victim_;
+                m_victim_ = (m_victim_ + 1) % s_slot_count_;
+            }
+            m_keys_[i] = obj;
+            m_traces_[i].m_size_ = 0;
+            return m_traces_[i];
+        }
+
+        /// forget [ an object allocated at a reused address has no trace yet ]
+        void forget(const void* obj) noexcept {
+            if (const std::size_t i = this->find(obj); i != s_slot_count_)
+                m_keys_[i] = nullptr;
+        }
+    };
+
+    constinit thread_local throw_ring t_throw_ring_;
+
+    /// __stacktrace::current_exception_object
+    // 'exception_ptr' holds the address of the primary thrown object, the
+    // same one '__cxa_throw' got, even when it was rethrown through
+    // 'std::rethrow_exception'
+    void* current_exception_object() noexcept {
+        static_assert(sizeof(std::exception_ptr) == sizeof(void*));
+        const std::exception_ptr current = std::current_exception();
+        void* obj;
+        std::memcpy(&obj, &current, sizeof(obj));
+        return obj;
+    }
+
+    /// __stacktrace::exception_pcs
+    const native_handle_type* exception_pcs(std::size_t& n) noexcept {
+        n = 0;
+        // only meaningful while an exception is being handled
+        if (abi::__cxa_current_exception_type() == nullptr)
+            return nullptr;
+        void* obj = current_exception_object();
+        const auto& ring = t_throw_ring_;
+        const std::size_t i = obj != nullptr ? ring.find(obj) : throw_ring::s_slot_count_;
+        if (i == throw_ring::s_slot_count_ || ring.m_traces_[i].m_size_ == 0)
+            return nullptr;
+        n = ring.m_traces_[i].m_size_;
+        return ring.m_traces_[i].m_pcs_;
+    }
+
+} // namespace gold::__stacktrace
+
+extern "C" {
+
+    // weak, as they are only defined when linking with '--wrap'
+
+    /// __real___cxa_allocate_exception [ provided by the linker ]
+    [[gnu::weak]] void* __real___cxa_allocate_exception(std::size_t) noexcept;
+
+    /// __real___cxa_throw [ provided by the linker ]
+    [[gnu::weak, noreturn]] void __real___cxa_throw(void*, std::type_info*, void (_GLIBCXX_CDTOR_CALLABI*)(void*));
+
+    /// __wrap___cxa_allocate_exception
+    void* __wrap___cxa_allocate_exception(std::size_t size) noexcept {
+        void* obj = __real___cxa_allocate_exception(size);
+        gold::__stacktrace::t_throw_ring_.forget(obj);
+        return obj;
+    }
+
+    /// __wrap___cxa_throw
+    // records the frames above this one, then hands over to the runtime
+    [[noreturn]] void __wrap___cxa_throw(void* obj, std::type_info* tinfo, void (_GLIBCXX_CDTOR_CALLABI* dest)(void*)) {
+        using namespace gold::__stacktrace;
+        auto& trace = t_throw_ring_.acquire(obj);
+        unwind(1, &throw_trace::push, &trace);
+        __real___cxa_throw(obj, tinfo, dest);
+    }
+
+} // extern "C"
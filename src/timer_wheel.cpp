@@ -0,0 +1,296 @@
+#include <bit>
+#include <condition_variable>
+#include <thread>
+#include <gold/timer_wheel>
+
+namespace gold {
+
+    /// timer_wheel ctor
+    timer_wheel::timer_wheel(clock::duration tick, gold::move_only_function<void()> on_earlier)
+    : m_epoch_(clock::now()), m_tick_(tick), m_on_earlier_(std::move(on_earlier)) {
+        for (auto& head : m_slots_)
+            head.m_prev_ = head.m_next_ = &head;
+    }
+
+    /// mf_tick_ceil_ [ the first tick at or after 'tp' ]
+    std::uint64_t timer_wheel::mf_tick_ceil_(clock::time_point tp) const noexcept {
+        const clock::duration d = tp - m_epoch_;
+        if (d <= clock::duration::zero())
+            return 0;
+        return static_cast<std::uint64_t>(d / m_tick_) + (d % m_tick_ != clock::duration::zero());
+    }
+
+    /// mf_link_ [ pre: 'm_deadline_' of 't' is not before the current tick ]
+    void timer_wheel::mf_link_(timer& t) noexcept {
+        std::uint64_t deadline = t.m_deadline_;
+        std::uint64_t delta    = deadline - m_current_;
+        if (delta >= s_range_) {
+            // out of range: parked in the farthest slot and linked again
+            // when the wheel turns past it
+            delta    = s_range_ - 1;
+            deadline = m_current_ + delta;
+        }
+        const std::size_t level = delta == 0 ? 0 : (std::bit_width(delta) - 1) / s_slot_bits_;
+        const std::size_t slot  = (deadline >> (level * s_slot_bits_)) & (s_slots_ - 1);
+        const std::size_t index = level * s_slots_ + slot;
+
+        __timer::link& head = m_slots_[index];
+        __timer::link& self = t;
+        self.m_prev_ = head.m_prev_;
+        self.m_next_ = &head;
+        head.m_prev_->m_next_ = &self;
+        head.m_prev_ = &self;
+        t.m_slot_ = static_cast<std::uint16_t>(index);
+        m_occupied_[index / 64] |= std::uint64_t(1) << (index % 64);
+    }
+
+    /// mf_unlink_
+    void timer_wheel::mf_unlink_(timer& t) noexcept {
+        __timer::link& self = t;
+        self.m_prev_->m_next_ = self.m_next_;
+        self.m_next_->m_prev_ = self.m_prev_;
+        const std::size_t index = t.m_slot_;
+        if (m_slots_[index].m_next_ == &m_slots_[index])
+            m_occupied_[index / 64] &= ~(std::uint64_t(1) << (index % 64));
+    }
+
+    /// mf_cascade_ [ links the timers of the current slot of 'level' one level down ]
+    void timer_wheel::mf_cascade_(std::size_t level) noexcept {
+        const std::size_t index = level * s_slots_ + ((m_current_ >> (level * s_slot_bits_)) & (s_slots_ - 1));
+        __timer::link& head = m_slots_[index];
+        __timer::link* cur  = head.m_next_;
+        head.m_prev_ = head.m_next_ = &head;
+        m_occupied_[index / 64] &= ~(std::uint64_t(1) << (index % 64));
+        while (cur != &head) {
+            __timer::link* next = cur->m_next_;
+            this->mf_link_(static_cast<timer&>(*cur));
+            cur = next;
+        }
+    }
+
+    /// mf_any_occupied_
+    bool timer_wheel::mf_any_occupied_(std::size_t level) const noexcept {
+        for (std::size_t i = 0; i < s_slots_ / 64; ++i)
+            if (m_occupied_[level * s_slots_ / 64 + i] != 0)
+                return true;
+        return false;
+    }
+
+    /// mf_ahead_ [ slots from 'pos' to the next occupied one of 'level', zero if none ]
+    std::size_t timer_wheel::mf_ahead_(std::size_t level, std::uint64_t pos) const noexcept {
+        for (std::size_t n = 1; n <= s_slots_; ) {
+            const std::size_t slot = (pos + n) & (s_slots_ - 1);
+            const std::uint64_t word = m_occupied_[(level * s_slots_ + slot) / 64] >> (slot % 64);
+            if (word != 0) {
+                const std::size_t ahead = n + static_cast<std::size_t>(std::countr_zero(word));
+                return ahead <= s_slots_ ? ahead : 0;
+            }
+            n += 64 - slot % 64;
+        }
+        return 0;
+    }
+
+    /// mf_next_due_ [ pre: a timer is pending ]
+    // the first occupied slot of level 0, or the first turn at which an
+    // occupied slot of a coarser level cascades, whichever comes first
+    std::uint64_t timer_wheel::mf_next_due_() const noexcept {
+        std::uint64_t result = UINT64_MAX;
+        for (std::size_t level = 0; level < s_levels_; ++level) {
+            const std::size_t   shift = level * s_slot_bits_;
+            const std::uint64_t pos   = m_current_ >> shift;
+            if (const std::size_t ahead = this->mf_ahead_(level, pos); ahead != 0)
+                result = std::min(result, (pos + ahead) << shift);
+        }
+        return result;
+    }
+
+    /// schedule
+    void timer_wheel::schedule(timer& t, clock::time_point deadline) {
+        bool earlier;
+        {
+            std::lock_guard guard (m_mtx_);
+            if (t.m_state_ == __timer::state::pending_state)
+                this->mf_unlink_(t);
+            else
+                ++m_size_;
+            if (t.m_state_ == __timer::state::fired_state)
+                t.m_early_ = false;
+
+            // a timer expired before it was scheduled is due right away
+            t.m_deadline_ = t.m_early_ ? m_current_ + 1 : std::max(this->mf_tick_ceil_(deadline), m_current_ + 1);
+            t.m_state_    = __timer::state::pending_state;
+            this->mf_link_(t);
+
+            earlier = t.m_deadline_ < m_wake_tick_;
+            if (earlier)
+                m_wake_tick_ = t.m_deadline_;
+        }
+        if (earlier && m_on_earlier_)
+            m_on_earlier_();
+    }
+
+    /// cancel
+    bool timer_wheel::cancel(timer& t) noexcept {
+        std::lock_guard guard (m_mtx_);
+        if (t.m_state_ != __timer::state::pending_state) {
+            if (t.m_state_ == __timer::state::idle_state)
+                t.m_early_ = false;
+            return false;
+        }
+        this->mf_unlink_(t);
+        --m_size_;
+        t.m_state_ = __timer::state::idle_state;
+        t.m_early_ = false;
+        return true;
+    }
+
+    /// expire_now
+    bool timer_wheel::expire_now(timer& t) noexcept {
+        bool earlier;
+        {
+            std::lock_guard guard (m_mtx_);
+            if (t.m_state_ == __timer::state::fired_state)
+                return false;
+            t.m_early_ = true;
+            if (t.m_state_ == __timer::state::idle_state)
+                return false;
+
+            this->mf_unlink_(t);
+            t.m_deadline_ = m_current_ + 1;
+            this->mf_link_(t);
+
+            earlier = t.m_deadline_ < m_wake_tick_;
+            if (earlier)
+                m_wake_tick_ = t.m_deadline_;
+        }
+        if (earlier && m_on_earlier_)
+            m_on_earlier_();
+        return true;
+    }
+
+    /// advance
+    std::size_t timer_wheel::advance(clock::time_point now) {
+        __timer::link expired;
+        expired.m_prev_ = expired.m_next_ = &expired;
+        std::size_t count = 0;
+        {
+            std::lock_guard guard (m_mtx_);
+            const clock::duration elapsed = now - m_epoch_;
+            const std::uint64_t target = elapsed > clock::duration::zero()
+                ? static_cast<std::uint64_t>(elapsed / m_tick_) : 0;
+
+            while (m_current_ < target) {
+                if (m_size_ == 0) {
+                    m_current_ = target;
+                    break;
+                }
+                // nothing on level 0: straight to its next turn
+                if (!this->mf_any_occupied_(0)) {
+                    const std::uint64_t last = m_current_ | (s_slots_ - 1);
+                    if (last >= target) {
+                        m_current_ = target;
+                        break;
+                    }
+                    m_current_ = last;
+                }
+                ++m_current_;
+
+                // coarser levels first, so that what falls onto a slot
+                // cascading in the same tick moves on down with it
+                for (std::size_t level = s_levels_ - 1; level > 0; --level)
+                    if ((m_current_ & ((std::uint64_t(1) << (level * s_slot_bits_)) - 1)) == 0)
+                        this->mf_cascade_(level);
+
+                const std::size_t index = m_current_ & (s_slots_ - 1);
+                __timer::link& head = m_slots_[index];
+                if (head.m_next_ == &head)
+                    continue;
+                for (__timer::link* cur = head.m_next_; cur != &head; cur = cur->m_next_) {
+                    static_cast<timer&>(*cur).m_state_ = __timer::state::fired_state;
+                    ++count;
+                }
+                // the whole slot is spliced onto the batch
+                head.m_next_->m_prev_     = expired.m_prev_;
+                expired.m_prev_->m_next_  = head.m_next_;
+                head.m_prev_->m_next_     = &expired;
+                expired.m_prev_           = head.m_prev_;
+                head.m_prev_ = head.m_next_ = &head;
+                m_occupied_[index / 64] &= ~(std::uint64_t(1) << (index % 64));
+            }
+            m_size_ -= count;
+        }
+
+        // a fired timer may be gone once its callback returns
+        for (__timer::link* cur = expired.m_next_; cur != &expired; ) {
+            __timer::link* next = cur->m_next_;
+            timer& t = static_cast<timer&>(*cur);
+            t.m_fire_(t);
+            cur = next;
+        }
+        return count;
+    }
+
+    /// next_expiry
+    std::optional<timer_wheel::clock::time_point> timer_wheel::next_expiry() {
+        std::lock_guard guard (m_mtx_);
+        if (m_size_ == 0) {
+            m_wake_tick_ = UINT64_MAX;
+            return std::nullopt;
+        }
+        m_wake_tick_ = this->mf_next_due_();
+        return m_epoch_ + m_tick_ * static_cast<clock::rep>(m_wake_tick_);
+    }
+
+    /// size
+    std::size_t timer_wheel::size() const noexcept {
+        std::lock_guard guard (m_mtx_);
+        return m_size_;
+    }
+
+    namespace __timer {
+
+        /// __timer::global_driver
+        // never destroyed, so timers may still be awaited while statics
+        // are torn down; its thread sleeps until the next expiry
+        struct global_driver {
+            std::mutex              m_mtx_;
+            std::condition_variable m_cv_;
+            bool                    m_woken_ = false;
+            timer_wheel             m_wheel_;
+
+            global_driver()
+            : m_wheel_(std::chrono::milliseconds(1), [this] {
+                  {
+                      std::lock_guard guard (m_mtx_);
+                      m_woken_ = true;
+                  }
+                  m_cv_.notify_one();
+              }) {
+                std::thread([this] { this->run(); }).detach();
+            }
+
+            [[noreturn]] void run() {
+                for (;;) {
+                    const auto next = m_wheel_.next_expiry();
+                    {
+                        std::unique_lock lock (m_mtx_);
+                        if (next)
+                            m_cv_.wait_until(lock, *next, [this] { return m_woken_; });
+                        else
+                            m_cv_.wait(lock, [this] { return m_woken_; });
+                        m_woken_ = false;
+                    }
+                    m_wheel_.advance();
+                }
+            }
+        };
+
+    } // namespace __timer
+
+    /// global
+    timer_wheel& timer_wheel::global() {
+        static auto* driver = new __timer::global_driver;
+        return driver->m_wheel_;
+    }
+
+} // namespace gold